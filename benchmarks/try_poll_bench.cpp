@@ -0,0 +1,112 @@
+// Measures producer throughput on a Channel while pollers spin on try_get.
+//
+// The consumer drains with get_batch, so the channel is almost always empty
+// and the pollers mostly see EMPTY (the hit rate is printed). Each poller
+// count runs twice: once with the lock-free rejection path, and once with
+// pollers that take the mutex before rejecting, like try_get used to. With
+// the lock-free path, throughput should stay close to the zero-poller
+// baseline as pollers are added, while the locked column falls off.
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "channel.hpp"
+
+namespace {
+
+constexpr size_t N = 64;
+
+// Exposes a try_get that always locks, for comparison
+struct BenchChannel : Channel<size_t, N> {
+    pointer locked_try_get(Result& result) {
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        if (closed_) {
+            result = Result::CLOSED;
+            return nullptr;
+        } else if (size() == 0) {
+            result = Result::EMPTY;
+            return nullptr;
+        }
+        lock.unlock();
+        return try_get(result);
+    }
+};
+
+struct Sample {
+    double throughput = 0;
+    double empty_ratio = 0;
+};
+
+template <bool Locked>
+Sample run(size_t num_pollers, size_t messages) {
+    BenchChannel ch;
+    std::atomic<bool> done{false};
+    std::atomic<size_t> polls{0};
+    std::atomic<size_t> empties{0};
+
+    std::vector<std::thread> pollers;
+    for (size_t i = 0; i < num_pollers; ++i) {
+        pollers.emplace_back([&]() {
+            size_t local_polls = 0;
+            size_t local_empties = 0;
+            ChannelBase::Result result;
+            while (!done.load(std::memory_order_relaxed)) {
+                if constexpr (Locked) {
+                    ch.locked_try_get(result);
+                } else {
+                    ch.try_get(result);
+                }
+                local_polls++;
+                if (result == ChannelBase::Result::EMPTY) {
+                    local_empties++;
+                }
+            }
+            polls.fetch_add(local_polls, std::memory_order_relaxed);
+            empties.fetch_add(local_empties, std::memory_order_relaxed);
+        });
+    }
+
+    std::thread consumer([&]() {
+        std::vector<BenchChannel::pointer> batch;
+        while (ch.get_batch(batch, N) != 0) {
+            batch.clear();
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < messages; ++i) {
+        ch.add(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ch.close();
+    consumer.join();
+    done = true;
+    for (auto& p : pollers) p.join();
+
+    Sample sample;
+    sample.throughput = messages / std::chrono::duration<double>(elapsed).count();
+    sample.empty_ratio = polls ? static_cast<double>(empties) / polls : 1.0;
+    return sample;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    size_t messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t max_pollers = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8;
+
+    std::cout << "messages: " << messages << "\n";
+    std::cout << "pollers\tlock-free msgs/sec\tlocked msgs/sec\tEMPTY polls (lock-free)\n";
+    for (size_t pollers = 0; pollers <= max_pollers; pollers = pollers ? pollers * 2 : 1) {
+        Sample lock_free = run<false>(pollers, messages);
+        Sample locked = run<true>(pollers, messages);
+        std::cout << pollers << "\t" << static_cast<size_t>(lock_free.throughput)
+                  << "\t" << static_cast<size_t>(locked.throughput)
+                  << "\t" << static_cast<int>(lock_free.empty_ratio * 100) << "%\n";
+    }
+    return 0;
+}
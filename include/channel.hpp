@@ -1,11 +1,37 @@
 #ifndef CHANNEL_H
 #define CHANNEL_H
 
+#include <algorithm>
 #include <iostream>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <chrono>
 #include <memory>
+#include <vector>
+#include "channel_allocation.hpp"
+
+// Hooks for the deterministic schedule tests. Builds that do not define them
+// get the standard primitives, the steady clock and schedule points that
+// compile to nothing.
+#ifndef CHANNEL_MUTEX_TYPE
+#define CHANNEL_MUTEX_TYPE std::mutex
+#endif
+
+#ifndef CHANNEL_CONDITION_VARIABLE_TYPE
+#define CHANNEL_CONDITION_VARIABLE_TYPE std::condition_variable
+#endif
+
+#ifndef CHANNEL_CLOCK
+#define CHANNEL_CLOCK std::chrono::steady_clock
+#endif
+
+#ifndef CHANNEL_SCHEDULE_POINT
+#define CHANNEL_SCHEDULE_POINT() ((void)0)
+#endif
+
+template <typename>
+inline constexpr bool dependent_false_v = false;
 
 class ChannelBase {
 public:
@@ -13,46 +39,78 @@ public:
         OK,
         CLOSED,
         FULL,
-        EMPTY
+        EMPTY,
+        INVALID
     };
 protected:
-    std::mutex sync_mutex_;
-    bool closed_ = false;
-    std::condition_variable consumer_cv_;
-    std::condition_variable producer_cv_;
+    using mutex_type = CHANNEL_MUTEX_TYPE;
+    using condition_variable_type = CHANNEL_CONDITION_VARIABLE_TYPE;
+    using clock_type = CHANNEL_CLOCK;
+
+    mutex_type sync_mutex_;
+    std::atomic<bool> closed_ = false; // Published for the lock-free try_add/try_get rejection paths
+    condition_variable_type consumer_cv_;
+    condition_variable_type producer_cv_;
 
     inline static Result dummy_result_;
 };
 
 // Channel class template
-template <typename Type, size_t N>
+template <typename Type, size_t N, typename Allocation = HeapAllocation>
 class Channel : public ChannelBase {
-    std::unique_ptr<Type> array[N];
+public:
+    using pointer = typename Allocation::template Pool<Type>::pointer;
+
+private:
+    typename Allocation::template Pool<Type> pool_; // Declared before the slots so it outlives them
+    pointer array[N];
     std::atomic<size_t> head_ = 0;
     std::atomic<size_t> tail_ = 0;
+    std::atomic<size_t> size_ = 0; // Written under sync_mutex_, read lock-free by try_add/try_get
 
     bool is_full() const {
-        return array[head_] != nullptr;
+        return size_.load(std::memory_order_relaxed) == N;
     }
 
     bool is_empty() const {
-        return array[tail_] == nullptr;
+        return size_.load(std::memory_order_relaxed) == 0;
     }
 
-    bool toBeClosed_ = false;
+    std::atomic<bool> toBeClosed_ = false;
+
+    // Consumer wakeup coalescing, see set_wakeup_coalescing()
+    size_t wake_batch_ = 1;
+    clock_type::duration wake_delay_{0};
+    clock_type::time_point arrived_[N]; // Enqueue time per slot, stamped only while coalescing
 
 public:
+    using allocator_type = typename Allocation::template Pool<Type>::allocator_type;
+
+    Channel() = default;
+
+    // Builds elements with a copy of `alloc`, e.g. a stateful arena allocator
+    explicit Channel(const allocator_type& alloc) : pool_(alloc) {}
 
     template <typename U>
     Result add(U&& var) {
-        std::unique_lock<std::mutex> lock(sync_mutex_);
+        std::unique_lock<mutex_type> lock(sync_mutex_);
         return adder(std::forward<U>(var), std::move(lock));
     }
 
     template <typename U>
     Result try_add(U&& var) {
-        std::unique_lock<std::mutex> lock(sync_mutex_);
-        if (closed_) {
+        // Reject without touching the mutex when there is nothing to do
+        if (closed_.load(std::memory_order_acquire) || toBeClosed_.load(std::memory_order_acquire)) {
+            return Result::CLOSED;
+        }
+        CHANNEL_SCHEDULE_POINT();
+        if (size_.load(std::memory_order_acquire) == N) {
+            return Result::FULL;
+        }
+        CHANNEL_SCHEDULE_POINT();
+
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        if (closed_ || toBeClosed_) {
             return Result::CLOSED; // Channel is closed
         } else if (is_full()) {
             return Result::FULL; // Channel is full
@@ -60,13 +118,27 @@ public:
         return adder(std::forward<U>(var), std::move(lock));
     }
 
-    std::unique_ptr<Type> get(Result& result = dummy_result_) {
-        std::unique_lock<std::mutex> lock(sync_mutex_);
+    pointer get(Result& result = dummy_result_) {
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        wait_for_items(lock);
         return getter(std::move(lock), result);
     }
 
-    std::unique_ptr<Type> try_get(Result& result = dummy_result_) {
-        std::unique_lock<std::mutex> lock(sync_mutex_);
+    // Never waits, so wakeup coalescing does not apply to it
+    pointer try_get(Result& result = dummy_result_) {
+        // Reject without touching the mutex when there is nothing to do
+        if (closed_.load(std::memory_order_acquire)) {
+            result = Result::CLOSED;
+            return nullptr;
+        }
+        CHANNEL_SCHEDULE_POINT();
+        if (size_.load(std::memory_order_acquire) == 0) {
+            result = Result::EMPTY;
+            return nullptr;
+        }
+        CHANNEL_SCHEDULE_POINT();
+
+        std::unique_lock<mutex_type> lock(sync_mutex_);
         if (closed_) {
             result = Result::CLOSED; // Channel is closed
             return nullptr; // Channel is closed
@@ -77,28 +149,106 @@ public:
         return getter(std::move(lock), result);
     }
 
+    // Takes up to max_items queued items in one go, appending them to out.
+    // Blocks like get() and returns how many were taken, so 0 means closed.
+    // A max_items of 0 is rejected with Result::INVALID without blocking.
+    size_t get_batch(std::vector<pointer>& out, size_t max_items, Result& result = dummy_result_) {
+        if (max_items == 0) {
+            result = Result::INVALID;
+            return 0;
+        }
+
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        wait_for_items(lock);
+
+        if (closed_) {
+            result = Result::CLOSED;
+            return 0;
+        }
+
+        size_t count = std::min(max_items, size_.load(std::memory_order_relaxed));
+        for (size_t i = 0; i < count; ++i) {
+            out.push_back(std::move(array[tail_]));
+            tail_ = (tail_ + 1) % N;
+        }
+        size_.fetch_sub(count, std::memory_order_release);
+        CHANNEL_SCHEDULE_POINT();
+
+        if (toBeClosed_ && is_empty()) {
+            closed_ = true;
+            consumer_cv_.notify_all();
+        }
+
+        lock.unlock(); // Unlock the mutex before notifying
+        CHANNEL_SCHEDULE_POINT();
+
+        producer_cv_.notify_all();
+
+        result = Result::OK;
+        return count;
+    }
+
+    size_t size() const {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    // Lets blocked consumers sleep until `batch` items are queued or
+    // `max_delay` has passed since the oldest queued item arrived, whichever
+    // comes first, trading latency for fewer wakeups. close() still wakes them
+    // at once, and try_get() never waits. The default, a batch of 1, wakes a
+    // consumer for every item.
+    void set_wakeup_coalescing(size_t batch, std::chrono::microseconds max_delay) {
+        std::lock_guard<mutex_type> lock(sync_mutex_);
+        wake_batch_ = std::min(std::max<size_t>(batch, 1), N);
+        wake_delay_ = std::chrono::ceil<clock_type::duration>(max_delay);
+    }
+
     void close() {
-        std::unique_lock<std::mutex> lock(sync_mutex_);
+        std::unique_lock<mutex_type> lock(sync_mutex_);
         toBeClosed_ = true;
+        CHANNEL_SCHEDULE_POINT();
         
         if (is_empty()) {
             closed_ = true;
         }
 
         lock.unlock(); // Unlock the mutex before notifying
+        CHANNEL_SCHEDULE_POINT();
 
         consumer_cv_.notify_all();
         producer_cv_.notify_all();
     }
 private:
-    std::unique_ptr<Type> getter(std::unique_lock<std::mutex> lock, Result& result) {
-        std::unique_ptr<Type> item = nullptr;
+    // Waits until the channel is closed or the coalescing policy releases a consumer
+    void wait_for_items(std::unique_lock<mutex_type>& lock) {
+        while (!closed_) {
+            size_t size = size_.load(std::memory_order_relaxed);
+            if (size >= wake_batch_ || (size != 0 && toBeClosed_)) {
+                return;
+            } else if (size == 0) {
+                consumer_cv_.wait(lock);
+                continue;
+            }
+
+            auto deadline = arrived_[tail_] + wake_delay_;
+            if (clock_type::now() >= deadline) {
+                return;
+            }
+            consumer_cv_.wait_until(lock, deadline);
+        }
+    }
+
+    // Takes the oldest item; get() has already applied the coalescing wait
+    pointer getter(std::unique_lock<mutex_type> lock, Result& result) {
+        pointer item;
 
         consumer_cv_.wait(lock, [this] { return closed_ || !is_empty(); });
 
         if (!closed_) {
             size_t tail_current = tail_;
             tail_ = (tail_ + 1) % N;
+            size_.fetch_sub(1, std::memory_order_release);
+            CHANNEL_SCHEDULE_POINT();
 
             bool lastOne = is_empty(); //if next is empty this one is the last one
 
@@ -110,6 +260,7 @@ private:
             item = std::move(array[tail_current]);
 
             lock.unlock(); // Unlock the mutex before notifying 
+            CHANNEL_SCHEDULE_POINT();
 
             producer_cv_.notify_one();
 
@@ -122,28 +273,41 @@ private:
     }
 
     template <typename U>
-    Result adder(U&& var, std::unique_lock<std::mutex> lock) {
+    Result adder(U&& var, std::unique_lock<mutex_type> lock) {
         producer_cv_.wait(lock, [this] { return closed_ || toBeClosed_ || !is_full(); });
-        
-        size_t head_local = head_;
-        head_ = (head_ + 1) % N;
 
         if (closed_ || toBeClosed_) {
             return Result::CLOSED;
         }
 
+        size_t head_local = head_;
+        head_ = (head_ + 1) % N;
+
         if constexpr (std::is_move_constructible_v<Type>) {
-            array[head_local] = std::make_unique<Type>(std::forward<U>(var));
+            array[head_local] = pool_.make(std::forward<U>(var));
         } else if constexpr (std::is_copy_constructible_v<Type>) {
-            array[head_local] = std::make_unique<Type>(var);
+            array[head_local] = pool_.make(var);
         } else {
             array[head_local] = nullptr; // Clear the slot
-            static_assert(false, "Type is neither move nor copy constructible");
+            static_assert(dependent_false_v<Type>, "Type is neither move nor copy constructible");
         }
-        
+        if (wake_batch_ != 1) {
+            arrived_[head_local] = clock_type::now();
+        }
+        CHANNEL_SCHEDULE_POINT();
+        size_t size = size_.fetch_add(1, std::memory_order_release) + 1;
+
+        // Without coalescing every item wakes a consumer. With it, wake one
+        // for the first item so it can arm its deadline, then once more when
+        // the batch completes, not for every item queued past it
+        bool wake = wake_batch_ == 1 || size == wake_batch_ || size == 1;
+
         lock.unlock(); // Unlock the mutex before notifying
-        
-        consumer_cv_.notify_one();
+        CHANNEL_SCHEDULE_POINT();
+
+        if (wake) {
+            consumer_cv_.notify_one();
+        }
         return Result::OK;
     }
 };
@@ -151,18 +315,36 @@ private:
 
 
 
-template <typename Type>
-class Channel<Type, 0> : public ChannelBase {
+template <typename Type, typename Allocation>
+class Channel<Type, 0, Allocation> : public ChannelBase {
 public:
+    using pointer = typename Allocation::template Pool<Type>::pointer;
+    using allocator_type = typename Allocation::template Pool<Type>::allocator_type;
+
+    Channel() = default;
+
+    // Builds elements with a copy of `alloc`, e.g. a stateful arena allocator
+    explicit Channel(const allocator_type& alloc) : pool_(alloc) {}
+
     template <typename U>
     Result add(U&& var) {
-        std::unique_lock<std::mutex> lock(sync_mutex_);
+        std::unique_lock<mutex_type> lock(sync_mutex_);
         return adder(std::forward<U>(var), std::move(lock));
     }
 
     template <typename U>
     Result try_add(U&& var) {
-        std::unique_lock<std::mutex> lock(sync_mutex_);
+        // Reject without touching the mutex when there is nothing to do
+        if (closed_.load(std::memory_order_acquire)) {
+            return Result::CLOSED;
+        }
+        CHANNEL_SCHEDULE_POINT();
+        if (consumer_waiting_.load(std::memory_order_acquire) == 0) {
+            return Result::FULL;
+        }
+        CHANNEL_SCHEDULE_POINT();
+
+        std::unique_lock<mutex_type> lock(sync_mutex_);
         if (closed_) {
             return Result::CLOSED;  // Channel is closed
         } else if (consumer_waiting_ == 0) {
@@ -172,15 +354,27 @@ public:
     }
 
 
-    std::unique_ptr<Type> get(Result& result = dummy_result_) {
-        std::unique_lock<std::mutex> lock(sync_mutex_);
+    pointer get(Result& result = dummy_result_) {
+        std::unique_lock<mutex_type> lock(sync_mutex_);
 
         return getter(std::move(lock), result);
     }
 
 
-    std::unique_ptr<Type> try_get(Result& result = dummy_result_) {
-        std::unique_lock<std::mutex> lock(sync_mutex_);
+    pointer try_get(Result& result = dummy_result_) {
+        // Reject without touching the mutex when there is nothing to do
+        if (closed_.load(std::memory_order_acquire)) {
+            result = Result::CLOSED;
+            return nullptr;
+        }
+        CHANNEL_SCHEDULE_POINT();
+        if (producer_waiting_.load(std::memory_order_acquire) == 0) {
+            result = Result::EMPTY;
+            return nullptr;
+        }
+        CHANNEL_SCHEDULE_POINT();
+
+        std::unique_lock<mutex_type> lock(sync_mutex_);
         if (closed_) {
             result = Result::CLOSED;  // Channel is closed
             return nullptr;  // Channel is closed
@@ -193,20 +387,22 @@ public:
 
 
 void close() {
-    std::unique_lock<std::mutex> lock(sync_mutex_);
+    std::unique_lock<mutex_type> lock(sync_mutex_);
 
     closed_ = true;
 
     lock.unlock(); // Unlock the mutex before notifying
+    CHANNEL_SCHEDULE_POINT();
     
-    consumer_cv_.notify_one();
-    producer_cv_.notify_one();
+    consumer_cv_.notify_all();
+    producer_cv_.notify_all();
 }
 
 private:
 
-    std::unique_ptr<Type> getter(std::unique_lock<std::mutex> lock, Result& result) {
+    pointer getter(std::unique_lock<mutex_type> lock, Result& result) {
         consumer_waiting_++;
+        CHANNEL_SCHEDULE_POINT();
 
         // Notify producers we're ready
         producer_cv_.notify_one();
@@ -215,8 +411,9 @@ private:
         consumer_cv_.wait(lock, [this] { return closed_ || handoff_; });
 
         consumer_waiting_--;
+        CHANNEL_SCHEDULE_POINT();
 
-        std::unique_ptr<Type> item = nullptr;
+        pointer item;
         if (handoff_) {
             item = std::move(handoff_);
             handoff_ = nullptr; // Clear the handoff
@@ -227,6 +424,7 @@ private:
         }
 
         lock.unlock(); // Unlock the mutex before notifying
+        CHANNEL_SCHEDULE_POINT();
 
         producer_cv_.notify_one();
 
@@ -234,35 +432,40 @@ private:
     }
 
     template <typename U>
-    Result adder(U&& var, std::unique_lock<std::mutex> lock) {
+    Result adder(U&& var, std::unique_lock<mutex_type> lock) {
 
         producer_waiting_++;
+        CHANNEL_SCHEDULE_POINT();
 
         // Wait until consumer is waiting
         producer_cv_.wait(lock, [this] { return closed_ || (consumer_waiting_ > 0 && !handoff_); });
 
         if (closed_) {
+            producer_waiting_--;
             return Result::CLOSED;
         }
 
         if constexpr (std::is_move_constructible_v<Type>) {
-            handoff_ = std::make_unique<Type>(std::forward<U>(var));
+            handoff_ = pool_.make(std::forward<U>(var));
         } else if constexpr (std::is_copy_constructible_v<Type>) {
-            handoff_ = std::make_unique<Type>(var);
+            handoff_ = pool_.make(var);
         } else {
             handoff_ = nullptr; // Clear the handoff
-            static_assert(false, "Type is neither move nor copy constructible");
+            static_assert(dependent_false_v<Type>, "Type is neither move nor copy constructible");
         }
         producer_waiting_--;
+        CHANNEL_SCHEDULE_POINT();
 
         lock.unlock(); // Unlock the mutex before notifying
+        CHANNEL_SCHEDULE_POINT();
         
         // Wake consumer
         consumer_cv_.notify_one();
         return Result::OK;
     }    
 
-    std::unique_ptr<Type> handoff_;
+    typename Allocation::template Pool<Type> pool_; // Declared before handoff_ so it outlives it
+    pointer handoff_;
     std::atomic<size_t> producer_waiting_ = 0;
     std::atomic<size_t> consumer_waiting_ = 0;
 };
@@ -0,0 +1,155 @@
+#ifndef CHANNEL_ALLOCATION_H
+#define CHANNEL_ALLOCATION_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+// Allocation policies for the elements a Channel hands out.
+//
+// A policy exposes `Pool<Type>` with a `pointer` type (what get() returns),
+// an `allocator_type` it can be constructed from (see Channel(const
+// allocator_type&)) and a `make(args...)` that builds an element. Channels only call make()
+// while holding their mutex; the returned pointer may be destroyed anywhere.
+
+// Every element comes from global operator new and is returned as a plain
+// std::unique_ptr<Type>. This is the default and keeps the original API.
+struct HeapAllocation {
+    template <typename Type>
+    class Pool {
+    public:
+        using pointer = std::unique_ptr<Type>;
+        using allocator_type = std::allocator<Type>;
+
+        Pool() = default;
+        explicit Pool(const allocator_type&) {} // Stateless, nothing to keep
+
+        template <typename... Args>
+        pointer make(Args&&... args) {
+            return std::make_unique<Type>(std::forward<Args>(args)...);
+        }
+    };
+};
+
+// Elements live in blocks obtained from Alloc and recycled through a
+// per-channel freelist. Consumers return blocks from any thread with a
+// lock-free push; producers pop under the channel mutex, so the freelist
+// never sees concurrent pops and is ABA-free. Once warmed up, steady-state
+// message passing performs no allocations at all.
+//
+// The pool outlives its channel while any element is still held by a
+// consumer; the last block returned releases it.
+template <typename Alloc = std::allocator<std::byte>>
+struct PoolAllocation {
+    template <typename Type>
+    class Pool {
+        union Node {
+            Node* next;
+            alignas(Type) unsigned char storage[sizeof(Type)];
+        };
+
+        struct State;
+
+        using NodeAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+        using StateAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<State>;
+
+        struct State {
+            explicit State(const Alloc& alloc) : node_alloc_(alloc) {}
+
+            ~State() {
+                free_list(free_.load(std::memory_order_acquire));
+                free_list(cache_);
+            }
+
+            void free_list(Node* node) {
+                while (node) {
+                    Node* next = node->next;
+                    std::allocator_traits<NodeAlloc>::deallocate(node_alloc_, node, 1);
+                    node = next;
+                }
+            }
+
+            void push(Node* node) {
+                Node* head = free_.load(std::memory_order_relaxed);
+                do {
+                    node->next = head;
+                } while (!free_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+            }
+
+            Node* pop() {
+                if (!cache_) {
+                    cache_ = free_.exchange(nullptr, std::memory_order_acquire);
+                }
+                if (!cache_) {
+                    return std::allocator_traits<NodeAlloc>::allocate(node_alloc_, 1);
+                }
+                Node* node = cache_;
+                cache_ = node->next;
+                return node;
+            }
+
+            void release() {
+                if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    StateAlloc state_alloc(node_alloc_);
+                    std::allocator_traits<StateAlloc>::destroy(state_alloc, this);
+                    std::allocator_traits<StateAlloc>::deallocate(state_alloc, this, 1);
+                }
+            }
+
+            NodeAlloc node_alloc_;
+            std::atomic<Node*> free_ = nullptr; // Pushed lock-free by deleters
+            Node* cache_ = nullptr;             // Popped by producers under the channel mutex
+            std::atomic<size_t> refs_ = 1;      // The owning Pool plus every live element
+        };
+
+    public:
+        struct Deleter {
+            State* state_ = nullptr;
+
+            void operator()(Type* ptr) const {
+                ptr->~Type();
+                state_->push(reinterpret_cast<Node*>(ptr));
+                state_->release();
+            }
+        };
+
+        using pointer = std::unique_ptr<Type, Deleter>;
+        using allocator_type = Alloc;
+
+        Pool() : Pool(Alloc()) {}
+
+        // Every block, including the pool state, comes from a copy of `alloc`
+        explicit Pool(const Alloc& alloc) {
+            StateAlloc state_alloc(alloc);
+            state_ = std::allocator_traits<StateAlloc>::allocate(state_alloc, 1);
+            std::allocator_traits<StateAlloc>::construct(state_alloc, state_, alloc);
+        }
+
+        Pool(const Pool&) = delete;
+        Pool& operator=(const Pool&) = delete;
+
+        ~Pool() {
+            state_->release();
+        }
+
+        template <typename... Args>
+        pointer make(Args&&... args) {
+            Node* node = state_->pop();
+            Type* ptr;
+            try {
+                ptr = ::new (static_cast<void*>(node->storage)) Type(std::forward<Args>(args)...);
+            } catch (...) {
+                state_->push(node);
+                throw;
+            }
+            state_->refs_.fetch_add(1, std::memory_order_relaxed);
+            return pointer(ptr, Deleter{state_});
+        }
+
+    private:
+        State* state_;
+    };
+};
+
+#endif // CHANNEL_ALLOCATION_H
@@ -0,0 +1,207 @@
+#ifndef DYNAMIC_CHANNEL_H
+#define DYNAMIC_CHANNEL_H
+
+#include <algorithm>
+#include <vector>
+#include "channel.hpp"
+
+// DynamicChannel class template
+//
+// Buffered channel whose capacity is chosen at run time. It starts at
+// `min_capacity` and doubles, up to `max_capacity`, once producers have found
+// it full `grow_after` times. After `shrink_window` consecutive gets that
+// leave it at most a quarter full, it halves again, never below
+// `min_capacity`; the window keeps a consumer that often drains the ring from
+// giving back room the next burst will need. Only gets count, so an idle
+// channel keeps its ring until traffic resumes. Resizing moves the queued
+// pointers into a new ring under the lock, preserving FIFO order.
+template <typename Type>
+class DynamicChannel : public ChannelBase {
+    std::vector<std::unique_ptr<Type>> array_;
+    size_t head_ = 0;
+    size_t tail_ = 0;
+    std::atomic<size_t> size_ = 0;
+    std::atomic<size_t> capacity_;
+
+    size_t min_capacity_;
+    size_t max_capacity_;
+    size_t grow_after_;
+    size_t shrink_window_;
+    size_t full_hits_ = 0;
+    size_t low_streak_ = 0;
+
+    bool toBeClosed_ = false;
+
+    bool is_full() const {
+        return size_ == capacity_;
+    }
+
+    bool is_empty() const {
+        return size_ == 0;
+    }
+
+public:
+    explicit DynamicChannel(size_t min_capacity, size_t max_capacity, size_t grow_after = 4, size_t shrink_window = 256)
+        : array_(std::max<size_t>(min_capacity, 1)),
+          capacity_(std::max<size_t>(min_capacity, 1)),
+          min_capacity_(std::max<size_t>(min_capacity, 1)),
+          max_capacity_(std::max(max_capacity, std::max<size_t>(min_capacity, 1))),
+          grow_after_(std::max<size_t>(grow_after, 1)),
+          shrink_window_(std::max<size_t>(shrink_window, 1)) {}
+
+    template <typename U>
+    Result add(U&& var) {
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        if (!closed_ && !toBeClosed_ && is_full()) {
+            make_room();
+        }
+        return adder(std::forward<U>(var), std::move(lock));
+    }
+
+    template <typename U>
+    Result try_add(U&& var) {
+        if (closed_.load(std::memory_order_acquire)) {
+            return Result::CLOSED;
+        }
+
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        if (closed_ || toBeClosed_) {
+            return Result::CLOSED; // Channel is closed
+        } else if (is_full() && !make_room()) {
+            return Result::FULL; // Channel is full and at its growth limit for now
+        }
+        return adder(std::forward<U>(var), std::move(lock));
+    }
+
+    std::unique_ptr<Type> get(Result& result = dummy_result_) {
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        return getter(std::move(lock), result);
+    }
+
+    std::unique_ptr<Type> try_get(Result& result = dummy_result_) {
+        if (closed_.load(std::memory_order_acquire)) {
+            result = Result::CLOSED;
+            return nullptr;
+        } else if (size_.load(std::memory_order_acquire) == 0) {
+            result = Result::EMPTY;
+            return nullptr;
+        }
+
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        if (closed_) {
+            result = Result::CLOSED; // Channel is closed
+            return nullptr;
+        } else if (is_empty()) {
+            result = Result::EMPTY; // Channel is empty
+            return nullptr;
+        }
+        return getter(std::move(lock), result);
+    }
+
+    size_t size() const {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const {
+        return capacity_.load(std::memory_order_acquire);
+    }
+
+    void close() {
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        toBeClosed_ = true;
+
+        if (is_empty()) {
+            closed_ = true;
+        }
+
+        lock.unlock(); // Unlock the mutex before notifying
+
+        consumer_cv_.notify_all();
+        producer_cv_.notify_all();
+    }
+
+private:
+    // Records a producer finding the channel full and grows it once that has
+    // happened often enough. Returns true if there is now room.
+    bool make_room() {
+        if (++full_hits_ < grow_after_ || capacity_ == max_capacity_) {
+            return false;
+        }
+        full_hits_ = 0;
+        resize(std::min(capacity_ * 2, max_capacity_));
+        producer_cv_.notify_all(); // Let every blocked producer use the new room
+        return true;
+    }
+
+    void resize(size_t capacity) {
+        std::vector<std::unique_ptr<Type>> next(capacity);
+        size_t count = size_;
+        for (size_t i = 0; i < count; ++i) {
+            next[i] = std::move(array_[(tail_ + i) % capacity_]);
+        }
+        array_.swap(next);
+        tail_ = 0;
+        head_ = count % capacity;
+        capacity_ = capacity;
+    }
+
+    std::unique_ptr<Type> getter(std::unique_lock<mutex_type> lock, Result& result) {
+        consumer_cv_.wait(lock, [this] { return closed_ || !is_empty(); });
+
+        if (closed_) {
+            result = Result::CLOSED;
+            return nullptr;
+        }
+
+        std::unique_ptr<Type> item = std::move(array_[tail_]);
+        tail_ = (tail_ + 1) % capacity_;
+        size_.fetch_sub(1, std::memory_order_release);
+
+        if (capacity_ > min_capacity_ && size_ <= capacity_ / 4) {
+            if (++low_streak_ >= shrink_window_) {
+                low_streak_ = 0;
+                resize(std::max(capacity_ / 2, min_capacity_));
+            }
+        } else {
+            low_streak_ = 0;
+        }
+
+        if (toBeClosed_ && is_empty()) {
+            closed_ = true;
+            consumer_cv_.notify_all();
+        }
+
+        lock.unlock(); // Unlock the mutex before notifying
+
+        producer_cv_.notify_one();
+
+        result = Result::OK;
+        return item;
+    }
+
+    template <typename U>
+    Result adder(U&& var, std::unique_lock<mutex_type> lock) {
+        producer_cv_.wait(lock, [this] { return closed_ || toBeClosed_ || !is_full(); });
+
+        if (closed_ || toBeClosed_) {
+            return Result::CLOSED;
+        }
+
+        if constexpr (std::is_move_constructible_v<Type>) {
+            array_[head_] = std::make_unique<Type>(std::forward<U>(var));
+        } else if constexpr (std::is_copy_constructible_v<Type>) {
+            array_[head_] = std::make_unique<Type>(var);
+        } else {
+            static_assert(dependent_false_v<Type>, "Type is neither move nor copy constructible");
+        }
+        head_ = (head_ + 1) % capacity_;
+        size_.fetch_add(1, std::memory_order_release);
+
+        lock.unlock(); // Unlock the mutex before notifying
+
+        consumer_cv_.notify_one();
+        return Result::OK;
+    }
+};
+
+#endif // DYNAMIC_CHANNEL_H
@@ -0,0 +1,192 @@
+#ifndef PRIORITY_CHANNEL_H
+#define PRIORITY_CHANNEL_H
+
+#include "channel.hpp"
+
+// PriorityChannel class template
+//
+// Lanes are independent rings of N slots each; lane 0 has the highest priority.
+// Consumers always take from the highest non-empty lane unless a lower lane
+// has been passed over `starvation_limit` times in a row, in which case that
+// lane is served once (aging). A limit of 0 means strict priority. A lane
+// index outside [0, Lanes) is rejected with Result::INVALID.
+template <typename Type, size_t N, size_t Lanes>
+class PriorityChannel : public ChannelBase {
+    static_assert(N > 0, "PriorityChannel lanes must be buffered");
+    static_assert(Lanes > 0, "PriorityChannel needs at least one lane");
+
+    struct Lane {
+        std::unique_ptr<Type> array[N];
+        size_t head_ = 0;
+        size_t tail_ = 0;
+        size_t count_ = 0;
+        size_t skipped_ = 0;
+        condition_variable_type producer_cv_;
+    };
+
+    Lane lanes_[Lanes];
+    size_t total_ = 0;
+    size_t starvation_limit_;
+
+    bool toBeClosed_ = false;
+
+    bool is_full(size_t lane) const {
+        return lanes_[lane].count_ == N;
+    }
+
+    bool is_empty() const {
+        return total_ == 0;
+    }
+
+public:
+    explicit PriorityChannel(size_t starvation_limit = 0)
+        : starvation_limit_(starvation_limit) {}
+
+    template <typename U>
+    Result add(size_t lane, U&& var) {
+        if (lane >= Lanes) {
+            return Result::INVALID;
+        }
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        return adder(lane, std::forward<U>(var), std::move(lock));
+    }
+
+    template <typename U>
+    Result try_add(size_t lane, U&& var) {
+        if (lane >= Lanes) {
+            return Result::INVALID;
+        }
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        if (closed_ || toBeClosed_) {
+            return Result::CLOSED; // Channel is closed
+        } else if (is_full(lane)) {
+            return Result::FULL; // Lane is full
+        }
+        return adder(lane, std::forward<U>(var), std::move(lock));
+    }
+
+    std::unique_ptr<Type> get(Result& result = dummy_result_) {
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        return getter(std::move(lock), result);
+    }
+
+    std::unique_ptr<Type> try_get(Result& result = dummy_result_) {
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        if (closed_) {
+            result = Result::CLOSED; // Channel is closed
+            return nullptr;
+        } else if (is_empty()) {
+            result = Result::EMPTY; // Every lane is empty
+            return nullptr;
+        }
+        return getter(std::move(lock), result);
+    }
+
+    // Items queued in `lane`, 0 for an invalid lane
+    size_t size(size_t lane) {
+        if (lane >= Lanes) {
+            return 0;
+        }
+        std::lock_guard<mutex_type> lock(sync_mutex_);
+        return lanes_[lane].count_;
+    }
+
+    void close() {
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        toBeClosed_ = true;
+
+        if (is_empty()) {
+            closed_ = true;
+        }
+
+        lock.unlock(); // Unlock the mutex before notifying
+
+        consumer_cv_.notify_all();
+        for (auto& lane : lanes_) {
+            lane.producer_cv_.notify_all();
+        }
+    }
+
+private:
+    // Picks the lane to serve next; the caller guarantees the channel is not empty.
+    size_t select_lane() {
+        size_t selected = Lanes;
+        for (size_t i = 0; i < Lanes; ++i) {
+            if (lanes_[i].count_ == 0) {
+                continue;
+            }
+            if (selected == Lanes) {
+                selected = i; // Highest non-empty lane
+            } else if (starvation_limit_ != 0 && lanes_[i].skipped_ >= starvation_limit_) {
+                selected = i; // Starved lower lane wins once
+                break;
+            }
+        }
+
+        for (size_t i = 0; i < Lanes; ++i) {
+            if (i == selected) {
+                lanes_[i].skipped_ = 0;
+            } else if (lanes_[i].count_ != 0) {
+                lanes_[i].skipped_++;
+            }
+        }
+        return selected;
+    }
+
+    std::unique_ptr<Type> getter(std::unique_lock<mutex_type> lock, Result& result) {
+        consumer_cv_.wait(lock, [this] { return closed_ || !is_empty(); });
+
+        if (closed_) {
+            result = Result::CLOSED;
+            return nullptr;
+        }
+
+        size_t index = select_lane();
+        Lane& lane = lanes_[index];
+
+        std::unique_ptr<Type> item = std::move(lane.array[lane.tail_]);
+        lane.tail_ = (lane.tail_ + 1) % N;
+        lane.count_--;
+        total_--;
+
+        if (toBeClosed_ && is_empty()) {
+            closed_ = true;
+            consumer_cv_.notify_all();
+        }
+
+        lock.unlock(); // Unlock the mutex before notifying
+
+        lane.producer_cv_.notify_one();
+
+        result = Result::OK;
+        return item;
+    }
+
+    template <typename U>
+    Result adder(size_t index, U&& var, std::unique_lock<mutex_type> lock) {
+        Lane& lane = lanes_[index];
+        lane.producer_cv_.wait(lock, [this, index] { return closed_ || toBeClosed_ || !is_full(index); });
+
+        if (closed_ || toBeClosed_) {
+            return Result::CLOSED;
+        }
+
+        if constexpr (std::is_move_constructible_v<Type>) {
+            lane.array[lane.head_] = std::make_unique<Type>(std::forward<U>(var));
+        } else if constexpr (std::is_copy_constructible_v<Type>) {
+            lane.array[lane.head_] = std::make_unique<Type>(var);
+        } else {
+            static_assert(dependent_false_v<Type>, "Type is neither move nor copy constructible");
+        }
+        lane.head_ = (lane.head_ + 1) % N;
+        lane.count_++;
+        total_++;
+
+        lock.unlock(); // Unlock the mutex before notifying
+
+        consumer_cv_.notify_one();
+        return Result::OK;
+    }
+};
+
+#endif // PRIORITY_CHANNEL_H
@@ -0,0 +1,370 @@
+#ifndef SPILL_CHANNEL_H
+#define SPILL_CHANNEL_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "channel.hpp"
+
+// Serializer used by SpillChannel to move items to and from disk.
+// Specialize it for your own types; it needs size(), write() and read().
+template <typename Type, typename Enable = void>
+struct ChannelSerializer;
+
+template <typename Type>
+struct ChannelSerializer<Type, std::enable_if_t<std::is_trivially_copyable_v<Type>>> {
+    static size_t size(const Type&) {
+        return sizeof(Type);
+    }
+
+    static void write(const Type& value, unsigned char* out) {
+        std::memcpy(out, &value, sizeof(Type));
+    }
+
+    static Type read(const unsigned char* in, size_t) {
+        Type value;
+        std::memcpy(&value, in, sizeof(Type));
+        return value;
+    }
+};
+
+template <>
+struct ChannelSerializer<std::string> {
+    static size_t size(const std::string& value) {
+        return value.size();
+    }
+
+    static void write(const std::string& value, unsigned char* out) {
+        std::memcpy(out, value.data(), value.size());
+    }
+
+    static std::string read(const unsigned char* in, size_t size) {
+        return std::string(reinterpret_cast<const char*>(in), size);
+    }
+};
+
+// SpillLog
+//
+// FIFO of length-prefixed records stored in fixed-size memory-mapped segment
+// files. Files are created unlinked in `directory`, so nothing is left behind,
+// and fully allocated, so running out of disk space only makes append() fail.
+// Fully read segments are kept mapped and reused; at most `max_segments`
+// exist at once. Not thread safe, the owning channel serializes access.
+class SpillLog {
+    struct Segment {
+        int fd_ = -1;
+        unsigned char* base_ = nullptr;
+        size_t read_ = 0;
+        size_t write_ = 0;
+    };
+
+    using Header = uint32_t;
+
+    std::string directory_;
+    size_t segment_size_;
+    size_t max_segments_;
+
+    std::deque<Segment> active_; // Oldest segment first; writes go to the back
+    std::vector<Segment> free_;  // Drained segments ready for reuse
+
+public:
+    SpillLog(std::string directory, size_t segment_size, size_t max_segments)
+        : directory_(std::move(directory)), segment_size_(segment_size), max_segments_(max_segments) {}
+
+    SpillLog(const SpillLog&) = delete;
+    SpillLog& operator=(const SpillLog&) = delete;
+
+    ~SpillLog() {
+        for (auto& segment : active_) {
+            unmap(segment);
+        }
+        for (auto& segment : free_) {
+            unmap(segment);
+        }
+    }
+
+    bool empty() const {
+        return active_.empty() || (active_.size() == 1 && active_.front().read_ == active_.front().write_);
+    }
+
+    size_t segments() const {
+        return active_.size() + free_.size();
+    }
+
+    // Reserves room for a record of `size` bytes and lets `writer` fill it.
+    // Returns false when the record does not fit under the segment cap.
+    template <typename Writer>
+    bool append(size_t size, Writer&& writer) {
+        size_t needed = sizeof(Header) + size;
+        if (needed > segment_size_ || size > UINT32_MAX) {
+            return false;
+        }
+
+        if (active_.empty() || segment_size_ - active_.back().write_ < needed) {
+            Segment segment;
+            if (!acquire(segment)) {
+                return false;
+            }
+            active_.push_back(segment);
+        }
+
+        Segment& segment = active_.back();
+        Header header = static_cast<Header>(size);
+        std::memcpy(segment.base_ + segment.write_, &header, sizeof(Header));
+        writer(segment.base_ + segment.write_ + sizeof(Header));
+        segment.write_ += needed;
+        return true;
+    }
+
+    // Hands the oldest record to `reader` and drops it; the log must not be empty.
+    template <typename Reader>
+    auto consume(Reader&& reader) {
+        Segment& segment = active_.front();
+        Header header;
+        std::memcpy(&header, segment.base_ + segment.read_, sizeof(Header));
+        auto value = reader(segment.base_ + segment.read_ + sizeof(Header), static_cast<size_t>(header));
+        segment.read_ += sizeof(Header) + header;
+
+        if (segment.read_ == segment.write_) {
+            if (active_.size() > 1) {
+                recycle(segment);
+                active_.pop_front();
+            } else {
+                segment.read_ = segment.write_ = 0;
+            }
+        }
+        return value;
+    }
+
+private:
+    bool acquire(Segment& segment) {
+        if (!free_.empty()) {
+            segment = free_.back();
+            free_.pop_back();
+            return true;
+        }
+        if (segments() >= max_segments_) {
+            return false;
+        }
+
+        std::string path = directory_ + "/channel-spill-XXXXXX";
+        std::vector<char> name(path.begin(), path.end());
+        name.push_back('\0');
+
+        int fd = ::mkstemp(name.data());
+        if (fd < 0) {
+            return false;
+        }
+        ::unlink(name.data());
+
+        // Reserve the blocks up front: a sparse file would SIGBUS on a full
+        // disk at first touch, this makes it look like a full log instead
+        if (::posix_fallocate(fd, 0, static_cast<off_t>(segment_size_)) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void* base = ::mmap(nullptr, segment_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (base == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+
+        segment.fd_ = fd;
+        segment.base_ = static_cast<unsigned char*>(base);
+        segment.read_ = segment.write_ = 0;
+        return true;
+    }
+
+    void recycle(Segment segment) {
+        segment.read_ = segment.write_ = 0; // Keeps its disk blocks, so reuse cannot fault
+        free_.push_back(segment);
+    }
+
+    void unmap(Segment& segment) {
+        ::munmap(segment.base_, segment_size_);
+        ::close(segment.fd_);
+    }
+};
+
+// SpillChannel class template
+//
+// Bounded channel that never blocks producers while its spill log has room:
+// when the N-slot ring is full, items are serialized to the log and read back
+// into the ring, in order, as consumers drain it. Producers only block once
+// the log reaches its segment cap or the disk has no room for a new segment.
+template <typename Type, size_t N, typename Serializer = ChannelSerializer<Type>>
+class SpillChannel : public ChannelBase {
+    static_assert(N > 0, "SpillChannel needs an in-memory ring");
+
+    std::unique_ptr<Type> array[N];
+    size_t head_ = 0;
+    size_t tail_ = 0;
+    std::atomic<size_t> size_ = 0;    // Items in the ring
+    std::atomic<size_t> spilled_ = 0; // Items in the log
+
+    SpillLog log_;
+
+    bool toBeClosed_ = false;
+
+    bool is_full() const {
+        return size_ == N;
+    }
+
+    bool is_empty() const {
+        return size_ == 0;
+    }
+
+public:
+    explicit SpillChannel(std::string directory, size_t segment_size = 1 << 20, size_t max_segments = 16)
+        : log_(std::move(directory), segment_size, max_segments) {}
+
+    template <typename U>
+    Result add(U&& var) {
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        producer_cv_.wait(lock, [&] { return closed_ || toBeClosed_ || push(var); });
+        return finish_add(std::move(lock));
+    }
+
+    template <typename U>
+    Result try_add(U&& var) {
+        if (closed_.load(std::memory_order_acquire)) {
+            return Result::CLOSED;
+        }
+
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        if (!closed_ && !toBeClosed_ && !push(var)) {
+            return Result::FULL; // Ring full and log at its cap
+        }
+        return finish_add(std::move(lock));
+    }
+
+    std::unique_ptr<Type> get(Result& result = dummy_result_) {
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        return getter(std::move(lock), result);
+    }
+
+    std::unique_ptr<Type> try_get(Result& result = dummy_result_) {
+        if (closed_.load(std::memory_order_acquire)) {
+            result = Result::CLOSED;
+            return nullptr;
+        } else if (size_.load(std::memory_order_acquire) == 0) {
+            result = Result::EMPTY;
+            return nullptr;
+        }
+
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        if (closed_) {
+            result = Result::CLOSED;
+            return nullptr;
+        } else if (is_empty()) {
+            result = Result::EMPTY;
+            return nullptr;
+        }
+        return getter(std::move(lock), result);
+    }
+
+    // Total queued items, in memory and on disk
+    size_t size() const {
+        return size_.load(std::memory_order_acquire) + spilled_.load(std::memory_order_acquire);
+    }
+
+    size_t spilled() const {
+        return spilled_.load(std::memory_order_acquire);
+    }
+
+    void close() {
+        std::unique_lock<mutex_type> lock(sync_mutex_);
+        toBeClosed_ = true;
+
+        if (is_empty()) {
+            closed_ = true;
+        }
+
+        lock.unlock(); // Unlock the mutex before notifying
+
+        consumer_cv_.notify_all();
+        producer_cv_.notify_all();
+    }
+
+private:
+    // Stores the item in the ring, or in the log once anything has spilled so
+    // FIFO order holds. Returns false when neither has room.
+    template <typename U>
+    bool push(U& var) {
+        if (spilled_ == 0 && !is_full()) {
+            if constexpr (std::is_same_v<std::decay_t<U>, Type> && !std::is_lvalue_reference_v<U>) {
+                array[head_] = std::make_unique<Type>(std::move(var));
+            } else {
+                array[head_] = std::make_unique<Type>(var);
+            }
+            head_ = (head_ + 1) % N;
+            size_.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+
+        const Type& value = var;
+        bool stored = log_.append(Serializer::size(value), [&](unsigned char* out) {
+            Serializer::write(value, out);
+        });
+        if (stored) {
+            spilled_.fetch_add(1, std::memory_order_release);
+        }
+        return stored;
+    }
+
+    Result finish_add(std::unique_lock<mutex_type> lock) {
+        if (closed_ || toBeClosed_) {
+            return Result::CLOSED;
+        }
+
+        lock.unlock(); // Unlock the mutex before notifying
+
+        consumer_cv_.notify_one();
+        return Result::OK;
+    }
+
+    std::unique_ptr<Type> getter(std::unique_lock<mutex_type> lock, Result& result) {
+        consumer_cv_.wait(lock, [this] { return closed_ || !is_empty(); });
+
+        if (closed_) {
+            result = Result::CLOSED;
+            return nullptr;
+        }
+
+        std::unique_ptr<Type> item = std::move(array[tail_]);
+        tail_ = (tail_ + 1) % N;
+        size_.fetch_sub(1, std::memory_order_release);
+
+        // Everything on disk is newer than the ring, so refill from the back
+        if (spilled_ != 0) {
+            array[head_] = log_.consume([](const unsigned char* in, size_t size) {
+                return std::make_unique<Type>(Serializer::read(in, size));
+            });
+            head_ = (head_ + 1) % N;
+            size_.fetch_add(1, std::memory_order_release);
+            spilled_.fetch_sub(1, std::memory_order_release);
+        }
+
+        if (toBeClosed_ && is_empty()) {
+            closed_ = true;
+            consumer_cv_.notify_all();
+        }
+
+        lock.unlock(); // Unlock the mutex before notifying
+
+        producer_cv_.notify_one();
+
+        result = Result::OK;
+        return item;
+    }
+};
+
+#endif // SPILL_CHANNEL_H
@@ -0,0 +1,214 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <thread>
+#include <vector>
+#include "channel.hpp"
+
+// Channel that timers deliver their firing time on. It holds one value, so a
+// reader that falls behind misses ticks instead of stalling the timer thread.
+using TimerChannel = Channel<std::chrono::steady_clock::time_point, 1>;
+
+// TimerWheel
+//
+// Hierarchical timer wheel shared by every after() and ticker() channel and
+// driven by a single thread. Level 0 has one slot per millisecond tick; each
+// higher level covers 64 times the span of the one below and cascades into
+// it as time reaches its slots. Deliveries use try_add, so a full channel
+// just drops that tick. A timer is cancelled by closing its channel or by
+// dropping every shared_ptr to it.
+class TimerWheel {
+public:
+    using clock = std::chrono::steady_clock;
+    using duration = std::chrono::milliseconds;
+
+    static TimerWheel& instance() {
+        static TimerWheel wheel;
+        return wheel;
+    }
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    ~TimerWheel() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stop_ = true;
+        lock.unlock(); // Unlock the mutex before notifying
+
+        cv_.notify_one();
+        thread_.join();
+    }
+
+    // Fires `channel` after `delay`, then every `period` if it is non-zero
+    void schedule(const std::shared_ptr<TimerChannel>& channel, duration delay, duration period) {
+        uint64_t now_tick = ticks_since_start(clock::now());
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (timers_ == 0) {
+            tick_ = now_tick; // Idle wheel skips straight to now
+        }
+
+        Timer timer;
+        timer.channel_ = channel;
+        timer.expiry_ = std::max(now_tick, tick_) + to_ticks(delay) + 1; // Round up, never fire early
+        timer.period_ = to_ticks(period);
+        insert(std::move(timer));
+
+        bool was_idle = timers_++ == 0;
+        lock.unlock(); // Unlock the mutex before notifying
+
+        if (was_idle) {
+            cv_.notify_one();
+        }
+    }
+
+    // Timers still scheduled, including ones being delivered
+    size_t pending() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return timers_;
+    }
+
+private:
+    static constexpr size_t kLevels = 4;
+    static constexpr size_t kSlotBits = 6;
+    static constexpr size_t kSlots = size_t(1) << kSlotBits;
+    static constexpr uint64_t kSlotMask = kSlots - 1;
+    static constexpr uint64_t kMaxDelta = (uint64_t(1) << (kSlotBits * kLevels)) - 1;
+
+    struct Timer {
+        std::weak_ptr<TimerChannel> channel_;
+        uint64_t expiry_ = 0; // Absolute tick
+        uint64_t period_ = 0; // Ticks between firings, 0 for one-shot
+    };
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<Timer> wheel_[kLevels][kSlots];
+    clock::time_point start_ = clock::now();
+    uint64_t tick_ = 0;
+    size_t timers_ = 0;
+    bool stop_ = false;
+    std::thread thread_;
+
+    TimerWheel() : thread_([this] { run(); }) {}
+
+    static uint64_t to_ticks(duration d) {
+        return d.count() > 0 ? static_cast<uint64_t>(d.count()) : 0;
+    }
+
+    uint64_t ticks_since_start(clock::time_point now) const {
+        return static_cast<uint64_t>(std::chrono::duration_cast<duration>(now - start_).count());
+    }
+
+    void insert(Timer timer) {
+        uint64_t delta = timer.expiry_ - tick_;
+        if (delta > kMaxDelta) {
+            // Too far out for the wheel: park it in the top-level slot that
+            // cascades last, where it is re-inserted with its real expiry
+            size_t top = kSlotBits * (kLevels - 1);
+            size_t slot = ((tick_ >> top) - 1) & kSlotMask;
+            wheel_[kLevels - 1][slot].push_back(std::move(timer));
+            return;
+        }
+
+        size_t level = 0;
+        while (level + 1 < kLevels && delta >= (uint64_t(1) << (kSlotBits * (level + 1)))) {
+            level++;
+        }
+        size_t slot = (timer.expiry_ >> (kSlotBits * level)) & kSlotMask;
+        wheel_[level][slot].push_back(std::move(timer));
+    }
+
+    // Moves the timers of the current tick's higher-level slots down the wheel
+    void cascade() {
+        for (size_t level = kLevels - 1; level > 0; --level) {
+            if ((tick_ & ((uint64_t(1) << (kSlotBits * level)) - 1)) != 0) {
+                continue;
+            }
+            size_t slot = (tick_ >> (kSlotBits * level)) & kSlotMask;
+            std::vector<Timer> timers;
+            timers.swap(wheel_[level][slot]);
+            for (auto& timer : timers) {
+                insert(std::move(timer));
+            }
+        }
+    }
+
+    void run() {
+        std::vector<Timer> due;
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        while (!stop_) {
+            if (timers_ == 0) {
+                cv_.wait(lock, [this] { return stop_ || timers_ != 0; });
+                continue;
+            }
+
+            cv_.wait_until(lock, start_ + duration(tick_ + 1), [this] { return stop_; });
+            if (stop_) {
+                break;
+            }
+
+            uint64_t now_tick = ticks_since_start(clock::now());
+            while (tick_ < now_tick) {
+                tick_++;
+                cascade();
+                auto& slot = wheel_[0][tick_ & kSlotMask];
+                std::move(slot.begin(), slot.end(), std::back_inserter(due));
+                slot.clear();
+            }
+            if (due.empty()) {
+                continue;
+            }
+
+            lock.unlock(); // Deliver without holding the wheel lock
+
+            auto now = clock::now();
+            for (auto& timer : due) {
+                auto channel = timer.channel_.lock();
+                if (!channel || channel->try_add(now) == ChannelBase::Result::CLOSED) {
+                    timer.period_ = 0; // Reader went away, cancel
+                } else if (timer.period_ == 0) {
+                    channel->close();
+                }
+            }
+
+            lock.lock();
+            for (auto& timer : due) {
+                if (timer.period_ != 0) {
+                    timer.expiry_ = std::max(timer.expiry_ + timer.period_, tick_ + 1);
+                    insert(std::move(timer));
+                } else {
+                    timers_--;
+                }
+            }
+            due.clear();
+        }
+    }
+};
+
+// Returns a channel that receives the current time once `delay` has passed
+// and is then closed.
+template <typename Rep, typename Period>
+std::shared_ptr<TimerChannel> after(std::chrono::duration<Rep, Period> delay) {
+    auto channel = std::make_shared<TimerChannel>();
+    auto ticks = std::chrono::ceil<TimerWheel::duration>(delay);
+    TimerWheel::instance().schedule(channel, ticks, TimerWheel::duration::zero());
+    return channel;
+}
+
+// Returns a channel that receives the current time every `period`. Close the
+// channel or drop it to stop the ticker.
+template <typename Rep, typename Period>
+std::shared_ptr<TimerChannel> ticker(std::chrono::duration<Rep, Period> period) {
+    auto channel = std::make_shared<TimerChannel>();
+    auto ticks = std::max(std::chrono::ceil<TimerWheel::duration>(period), TimerWheel::duration(1));
+    TimerWheel::instance().schedule(channel, ticks, ticks);
+    return channel;
+}
+
+#endif // TIMER_H
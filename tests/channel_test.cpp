@@ -447,6 +447,257 @@ TEST(ChannelSmartPtr, SharedPtrCopy) {
     EXPECT_EQ(**val, 99);
 }
 
+// Exposes the channel mutex so tests can prove the rejection paths never take it
+template <typename Type, size_t N>
+struct LockableChannel : Channel<Type, N> {
+    using ChannelBase::sync_mutex_;
+};
+
+// Runs `calls` while a helper thread holds the channel mutex. The helper
+// gives the mutex up after a timeout, so a regressed fast path shows up as a
+// failure instead of a hang. Returns true if `calls` never needed the mutex.
+template <typename Type, size_t N, typename Calls>
+bool runs_without_mutex(LockableChannel<Type, N>& ch, Calls calls) {
+    std::mutex state_mutex;
+    std::condition_variable state_cv;
+    bool locked = false;
+    bool done = false;
+    bool timed_out = false;
+
+    std::thread holder([&]() {
+        std::lock_guard<std::mutex> channel_lock(ch.sync_mutex_);
+        std::unique_lock<std::mutex> lock(state_mutex);
+        locked = true;
+        state_cv.notify_all();
+        timed_out = !state_cv.wait_for(lock, std::chrono::seconds(2), [&] { return done; });
+    });
+
+    {
+        std::unique_lock<std::mutex> lock(state_mutex);
+        state_cv.wait(lock, [&] { return locked; });
+    }
+
+    calls();
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        done = true;
+    }
+    state_cv.notify_all();
+    holder.join();
+    return !timed_out;
+}
+
+TEST(ChannelTryMethods, RejectionDoesNotTakeMutex) {
+    LockableChannel<int, 1> ch;
+    ChannelBase::Result result;
+
+    EXPECT_TRUE(runs_without_mutex(ch, [&]() {
+        EXPECT_FALSE(ch.try_get(result));
+        EXPECT_EQ(result, ChannelBase::Result::EMPTY);
+    }));
+
+    EXPECT_EQ(ch.try_add(1), ChannelBase::Result::OK);
+    EXPECT_EQ(ch.size(), 1u);
+
+    EXPECT_TRUE(runs_without_mutex(ch, [&]() {
+        EXPECT_EQ(ch.try_add(2), ChannelBase::Result::FULL);
+    }));
+
+    ch.close();
+
+    EXPECT_TRUE(runs_without_mutex(ch, [&]() {
+        EXPECT_EQ(ch.try_add(3), ChannelBase::Result::CLOSED); // Closing, not yet drained
+    }));
+
+    auto val = ch.try_get();
+    ASSERT_TRUE(val);
+    EXPECT_EQ(*val, 1);
+    EXPECT_EQ(ch.size(), 0u);
+
+    EXPECT_TRUE(runs_without_mutex(ch, [&]() {
+        EXPECT_FALSE(ch.try_get(result));
+        EXPECT_EQ(result, ChannelBase::Result::CLOSED);
+    }));
+}
+
+TEST(ChannelTryMethods, UnbufferedRejectionDoesNotTakeMutex) {
+    LockableChannel<int, 0> ch;
+    ChannelBase::Result result;
+
+    EXPECT_TRUE(runs_without_mutex(ch, [&]() {
+        EXPECT_EQ(ch.try_add(1), ChannelBase::Result::FULL);
+        EXPECT_FALSE(ch.try_get(result));
+        EXPECT_EQ(result, ChannelBase::Result::EMPTY);
+    }));
+}
+
+TEST(ChannelCoalescing, GetBatchTakesEverythingQueued) {
+    Channel<int, 8> ch;
+    for (int i = 0; i < 5; ++i) {
+        ch.add(i);
+    }
+
+    std::vector<Channel<int, 8>::pointer> out;
+    EXPECT_EQ(ch.get_batch(out, 3), 3u);
+    EXPECT_EQ(ch.get_batch(out, 10), 2u);
+    ASSERT_EQ(out.size(), 5u);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(*out[i], i);
+    }
+}
+
+TEST(ChannelCoalescing, GetBatchRejectsZeroItems) {
+    Channel<int, 8> ch;
+    ch.add(1);
+
+    std::vector<Channel<int, 8>::pointer> out;
+    ChannelBase::Result result;
+    EXPECT_EQ(ch.get_batch(out, 0, result), 0u);
+    EXPECT_EQ(result, ChannelBase::Result::INVALID);
+    EXPECT_TRUE(out.empty());
+    EXPECT_EQ(ch.size(), 1u);
+
+    // An empty channel must not block either
+    Channel<int, 8> empty;
+    EXPECT_EQ(empty.get_batch(out, 0, result), 0u);
+    EXPECT_EQ(result, ChannelBase::Result::INVALID);
+}
+
+TEST(ChannelCoalescing, WakesOnBatchThreshold) {
+    Channel<int, 8> ch;
+    ch.set_wakeup_coalescing(4, std::chrono::seconds(10));
+
+    std::atomic<bool> woke{false};
+    std::vector<Channel<int, 8>::pointer> out;
+    std::thread consumer([&]() {
+        ch.get_batch(out, 8);
+        woke = true;
+    });
+
+    for (int i = 0; i < 3; ++i) {
+        ch.add(i);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(woke); // Below the threshold and well before the deadline
+
+    ch.add(3);
+    consumer.join();
+    ASSERT_EQ(out.size(), 4u);
+    EXPECT_EQ(*out[3], 3);
+}
+
+TEST(ChannelCoalescing, WakesOnMaxDelay) {
+    Channel<int, 8> ch;
+    ch.set_wakeup_coalescing(8, std::chrono::milliseconds(20));
+
+    auto start = std::chrono::steady_clock::now();
+    ch.add(1);
+    auto val = ch.get();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_TRUE(val);
+    EXPECT_EQ(*val, 1);
+    EXPECT_GE(elapsed, std::chrono::milliseconds(20));
+    EXPECT_LT(elapsed, std::chrono::seconds(5));
+}
+
+TEST(ChannelCoalescing, TryGetDoesNotWait) {
+    Channel<int, 8> ch;
+    ch.set_wakeup_coalescing(8, std::chrono::seconds(10));
+
+    ch.add(1);
+    auto start = std::chrono::steady_clock::now();
+    auto val = ch.try_get();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_TRUE(val);
+    EXPECT_EQ(*val, 1);
+    EXPECT_LT(elapsed, std::chrono::seconds(1));
+}
+
+TEST(ChannelCoalescing, DelayRunsFromOldestQueuedItem) {
+    Channel<int, 8> ch;
+    ch.set_wakeup_coalescing(8, std::chrono::milliseconds(100));
+
+    ch.add(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    auto second_added = std::chrono::steady_clock::now();
+    ch.add(2);
+    ASSERT_TRUE(ch.try_get()); // Consumes the item the first deadline was based on
+
+    auto val = ch.get();
+    auto elapsed = std::chrono::steady_clock::now() - second_added;
+
+    ASSERT_TRUE(val);
+    EXPECT_EQ(*val, 2);
+    EXPECT_GE(elapsed, std::chrono::milliseconds(100));
+    EXPECT_LT(elapsed, std::chrono::seconds(5));
+}
+
+TEST(ChannelCoalescing, CloseFlushesImmediately) {
+    Channel<int, 8> ch;
+    ch.set_wakeup_coalescing(8, std::chrono::seconds(10));
+
+    std::vector<Channel<int, 8>::pointer> out;
+    std::thread consumer([&]() {
+        while (ch.get_batch(out, 8) != 0) {
+        }
+    });
+
+    ch.add(1);
+    ch.add(2);
+    auto start = std::chrono::steady_clock::now();
+    ch.close();
+    consumer.join();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(*out[0], 1);
+    EXPECT_EQ(*out[1], 2);
+}
+
+TEST(ChannelCoalescing, StressIntegrity) {
+    constexpr int NUM_PRODUCERS = 4;
+    constexpr int MESSAGES_PER_PRODUCER = 2000;
+    Channel<int, 16> ch;
+    ch.set_wakeup_coalescing(8, std::chrono::microseconds(200));
+
+    std::atomic<long> sum_consumed{0};
+    std::atomic<int> count_received{0};
+    std::vector<std::thread> producers;
+    std::vector<std::thread> consumers;
+
+    for (int i = 0; i < NUM_PRODUCERS; ++i) {
+        producers.emplace_back([&, i]() {
+            for (int j = 0; j < MESSAGES_PER_PRODUCER; ++j) {
+                ch.add(i * MESSAGES_PER_PRODUCER + j);
+            }
+        });
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        consumers.emplace_back([&]() {
+            std::vector<Channel<int, 16>::pointer> batch;
+            while (ch.get_batch(batch, 8) != 0) {
+                for (auto& val : batch) {
+                    sum_consumed.fetch_add(*val, std::memory_order_relaxed);
+                    count_received.fetch_add(1, std::memory_order_relaxed);
+                }
+                batch.clear();
+            }
+        });
+    }
+
+    for (auto& p : producers) p.join();
+    ch.close();
+    for (auto& c : consumers) c.join();
+
+    long total = NUM_PRODUCERS * MESSAGES_PER_PRODUCER;
+    EXPECT_EQ(count_received.load(), total);
+    EXPECT_EQ(sum_consumed.load(), total * (total - 1) / 2);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "dynamic_channel.hpp"
+
+TEST(DynamicChannel, GrowsWhenRepeatedlyFull) {
+    DynamicChannel<int> ch(2, 16, 2);
+
+    EXPECT_EQ(ch.try_add(0), ChannelBase::Result::OK);
+    EXPECT_EQ(ch.try_add(1), ChannelBase::Result::OK);
+    EXPECT_EQ(ch.try_add(2), ChannelBase::Result::FULL); // First hit
+    EXPECT_EQ(ch.capacity(), 2u);
+
+    EXPECT_EQ(ch.try_add(2), ChannelBase::Result::OK); // Second hit doubles
+    EXPECT_EQ(ch.capacity(), 4u);
+    EXPECT_EQ(ch.size(), 3u);
+
+    for (int i = 0; i < 3; ++i) {
+        auto val = ch.get();
+        ASSERT_TRUE(val);
+        EXPECT_EQ(*val, i);
+    }
+}
+
+TEST(DynamicChannel, StopsAtMaxCapacity) {
+    DynamicChannel<int> ch(1, 4, 1);
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(ch.try_add(i), ChannelBase::Result::OK);
+    }
+    EXPECT_EQ(ch.capacity(), 4u);
+    EXPECT_EQ(ch.try_add(4), ChannelBase::Result::FULL);
+    EXPECT_EQ(ch.capacity(), 4u);
+}
+
+TEST(DynamicChannel, ResizePreservesOrderAcrossWrap) {
+    DynamicChannel<int> ch(4, 64, 1, 1);
+
+    // Move the ring's tail away from slot 0 before growing
+    for (int i = 0; i < 3; ++i) {
+        ch.add(-1);
+        ch.get();
+    }
+
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(ch.try_add(i), ChannelBase::Result::OK);
+    }
+    EXPECT_EQ(ch.capacity(), 32u);
+
+    for (int i = 0; i < 20; ++i) {
+        auto val = ch.get();
+        ASSERT_TRUE(val);
+        EXPECT_EQ(*val, i);
+    }
+}
+
+TEST(DynamicChannel, ShrinksWhenOccupancyStaysLow) {
+    DynamicChannel<int> ch(2, 64, 1, 32);
+
+    int next_in = 0;
+    int next_out = 0;
+    for (; next_in < 40; ++next_in) {
+        ch.try_add(next_in);
+    }
+    EXPECT_EQ(ch.capacity(), 64u);
+
+    // Drain to 5 queued; the last 12 gets leave it at most a quarter full
+    for (; next_out < 35; ++next_out) {
+        auto val = ch.get();
+        ASSERT_TRUE(val);
+        EXPECT_EQ(*val, next_out);
+    }
+    EXPECT_EQ(ch.capacity(), 64u);
+
+    // Trickle traffic keeps occupancy low but never empty
+    for (int i = 0; i < 19; ++i) {
+        ch.add(next_in++);
+        auto val = ch.get();
+        ASSERT_TRUE(val);
+        EXPECT_EQ(*val, next_out++);
+        EXPECT_EQ(ch.size(), 5u);
+        EXPECT_EQ(ch.capacity(), 64u) << "shrank after " << 13 + i << " low gets";
+    }
+
+    // The 32nd consecutive low get completes the window
+    ch.add(next_in++);
+    auto val = ch.get();
+    ASSERT_TRUE(val);
+    EXPECT_EQ(*val, next_out++);
+    EXPECT_EQ(ch.capacity(), 32u);
+
+    for (; next_out < next_in; ++next_out) {
+        auto rest = ch.get();
+        ASSERT_TRUE(rest);
+        EXPECT_EQ(*rest, next_out);
+    }
+}
+
+TEST(DynamicChannel, DrainingDoesNotBypassShrinkWindow) {
+    DynamicChannel<int> ch(2, 64, 1, 32);
+
+    for (int i = 0; i < 40; ++i) {
+        ch.try_add(i);
+    }
+    EXPECT_EQ(ch.capacity(), 64u);
+
+    // Only 17 of these gets leave it a quarter full or less, including the last
+    for (int i = 0; i < 40; ++i) {
+        auto val = ch.get();
+        ASSERT_TRUE(val);
+        EXPECT_EQ(*val, i);
+    }
+    EXPECT_EQ(ch.size(), 0u);
+    EXPECT_EQ(ch.capacity(), 64u);
+}
+
+TEST(DynamicChannel, CloseDrains) {
+    DynamicChannel<int> ch(2, 8);
+    ch.add(1);
+    ch.add(2);
+    ch.close();
+    EXPECT_EQ(ch.add(3), ChannelBase::Result::CLOSED);
+
+    EXPECT_EQ(*ch.get(), 1);
+    EXPECT_EQ(*ch.get(), 2);
+
+    ChannelBase::Result result;
+    EXPECT_FALSE(ch.get(result));
+    EXPECT_EQ(result, ChannelBase::Result::CLOSED);
+}
+
+TEST(DynamicChannel, BlockedProducersGrowChannel) {
+    constexpr int NUM_PRODUCERS = 8;
+    constexpr int MESSAGES_PER_PRODUCER = 500;
+    DynamicChannel<int> ch(1, 128, 2, 64);
+
+    std::atomic<long> sum_consumed{0};
+    std::atomic<int> count_received{0};
+    std::vector<std::thread> producers;
+
+    for (int i = 0; i < NUM_PRODUCERS; ++i) {
+        producers.emplace_back([&, i]() {
+            for (int j = 0; j < MESSAGES_PER_PRODUCER; ++j) {
+                ch.add(i * MESSAGES_PER_PRODUCER + j);
+            }
+        });
+    }
+
+    std::thread consumer([&]() {
+        std::vector<int> last(NUM_PRODUCERS, -1);
+        for (auto val = ch.get(); val; val = ch.get()) {
+            int producer = *val / MESSAGES_PER_PRODUCER;
+            EXPECT_GT(*val, last[producer]); // Per-producer FIFO survives resizes
+            last[producer] = *val;
+            sum_consumed.fetch_add(*val, std::memory_order_relaxed);
+            count_received.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    for (auto& p : producers) p.join();
+    ch.close();
+    consumer.join();
+
+    long total = NUM_PRODUCERS * MESSAGES_PER_PRODUCER;
+    EXPECT_EQ(count_received.load(), total);
+    EXPECT_EQ(sum_consumed.load(), total * (total - 1) / 2);
+    EXPECT_LE(ch.capacity(), 128u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
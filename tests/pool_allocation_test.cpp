@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include "channel.hpp"
+
+// Count every global allocation made by this test binary
+static std::atomic<size_t> global_allocations{0};
+
+void* operator new(size_t size) {
+    global_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+// Allocator that counts the blocks it hands out
+static std::atomic<size_t> pool_allocations{0};
+static std::atomic<size_t> pool_deallocations{0};
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        pool_allocations.fetch_add(1, std::memory_order_relaxed);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* ptr, size_t n) {
+        pool_deallocations.fetch_add(1, std::memory_order_relaxed);
+        std::allocator<T>().deallocate(ptr, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+using CountingPool = PoolAllocation<CountingAllocator<std::byte>>;
+
+// Stateful allocator that charges its blocks to the arena it was built with
+struct Arena {
+    size_t live = 0;
+};
+
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena& arena) : arena_(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena_) {}
+
+    T* allocate(size_t n) {
+        arena_->live++;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* ptr, size_t n) {
+        arena_->live--;
+        std::allocator<T>().deallocate(ptr, n);
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena_ == other.arena_; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena_ != other.arena_; }
+
+    Arena* arena_;
+};
+
+TEST(PoolAllocation, SteadyStateDoesNoGlobalAllocations) {
+    Channel<int, 8, PoolAllocation<>> ch;
+
+    // Warm up the freelist
+    for (int i = 0; i < 8; ++i) {
+        ch.add(i);
+    }
+    for (int i = 0; i < 8; ++i) {
+        ch.get();
+    }
+
+    size_t before = global_allocations.load();
+    long sum = 0;
+    for (int round = 0; round < 1000; ++round) {
+        for (int i = 0; i < 8; ++i) {
+            ch.add(i);
+        }
+        for (int i = 0; i < 8; ++i) {
+            sum += *ch.get();
+        }
+    }
+    size_t after = global_allocations.load();
+
+    EXPECT_EQ(after - before, 0u);
+    EXPECT_EQ(sum, 1000 * 28);
+}
+
+TEST(PoolAllocation, CrossThreadFreesAreRecycled) {
+    pool_allocations = 0;
+    pool_deallocations = 0;
+    constexpr size_t N = 4;
+    constexpr int MESSAGES = 10000;
+
+    {
+        Channel<std::string, N, CountingPool> ch;
+
+        std::thread consumer([&]() {
+            int expected = 0;
+            for (auto val = ch.get(); val; val = ch.get()) {
+                EXPECT_EQ(*val, std::to_string(expected++));
+            }
+            EXPECT_EQ(expected, MESSAGES);
+        });
+
+        for (int i = 0; i < MESSAGES; ++i) {
+            ch.add(std::to_string(i));
+        }
+        ch.close();
+        consumer.join();
+
+        // One state block plus at most N queued, one in flight and one held by the consumer
+        EXPECT_LE(pool_allocations.load(), N + 3);
+    }
+
+    EXPECT_EQ(pool_allocations.load(), pool_deallocations.load());
+}
+
+TEST(PoolAllocation, ElementOutlivesChannel) {
+    pool_allocations = 0;
+    pool_deallocations = 0;
+
+    Channel<std::string, 2, CountingPool>::pointer held;
+    {
+        Channel<std::string, 2, CountingPool> ch;
+        ch.add(std::string("survivor"));
+        ch.add(std::string("dropped"));
+        held = ch.get();
+    }
+
+    ASSERT_TRUE(held);
+    EXPECT_EQ(*held, "survivor");
+    EXPECT_NE(pool_allocations.load(), pool_deallocations.load());
+
+    held.reset();
+    EXPECT_EQ(pool_allocations.load(), pool_deallocations.load());
+}
+
+TEST(PoolAllocation, AllocatorInstanceIsPassedThrough) {
+    using ArenaPool = PoolAllocation<ArenaAllocator<std::byte>>;
+    Arena first;
+    Arena second;
+
+    {
+        Channel<int, 4, ArenaPool> buffered(ArenaAllocator<std::byte>{first});
+        Channel<int, 0, ArenaPool> unbuffered(ArenaAllocator<std::byte>{second});
+
+        buffered.add(1);
+        buffered.add(2);
+        EXPECT_EQ(first.live, 3u); // Pool state plus two elements
+        EXPECT_EQ(second.live, 1u);
+
+        std::thread producer([&]() { unbuffered.add(3); });
+        auto val = unbuffered.get();
+        producer.join();
+        ASSERT_TRUE(val);
+        EXPECT_EQ(*val, 3);
+        EXPECT_EQ(second.live, 2u);
+    }
+
+    EXPECT_EQ(first.live, 0u);
+    EXPECT_EQ(second.live, 0u);
+}
+
+TEST(PoolAllocation, UnbufferedChannel) {
+    Channel<int, 0, PoolAllocation<>> ch;
+
+    std::thread producer([&]() {
+        for (int i = 0; i < 100; ++i) {
+            ch.add(i);
+        }
+    });
+
+    for (int i = 0; i < 100; ++i) {
+        auto val = ch.get();
+        ASSERT_TRUE(val);
+        EXPECT_EQ(*val, i);
+    }
+    producer.join();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
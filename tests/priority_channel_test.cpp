@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include "priority_channel.hpp"
+
+TEST(PriorityChannel, HighestLaneFirst) {
+    PriorityChannel<int, 4, 3> ch;
+
+    EXPECT_EQ(ch.add(2, 20), ChannelBase::Result::OK);
+    EXPECT_EQ(ch.add(1, 10), ChannelBase::Result::OK);
+    EXPECT_EQ(ch.add(0, 0), ChannelBase::Result::OK);
+    EXPECT_EQ(ch.add(2, 21), ChannelBase::Result::OK);
+
+    for (int expected : {0, 10, 20, 21}) {
+        auto val = ch.try_get();
+        ASSERT_TRUE(val);
+        EXPECT_EQ(*val, expected);
+    }
+
+    ChannelBase::Result result;
+    EXPECT_FALSE(ch.try_get(result));
+    EXPECT_EQ(result, ChannelBase::Result::EMPTY);
+}
+
+TEST(PriorityChannel, PerLaneCapacity) {
+    PriorityChannel<int, 2, 2> ch;
+
+    EXPECT_EQ(ch.try_add(1, 1), ChannelBase::Result::OK);
+    EXPECT_EQ(ch.try_add(1, 2), ChannelBase::Result::OK);
+    EXPECT_EQ(ch.try_add(1, 3), ChannelBase::Result::FULL);
+
+    // A full bulk lane never blocks the control lane
+    EXPECT_EQ(ch.try_add(0, 100), ChannelBase::Result::OK);
+    EXPECT_EQ(ch.size(0), 1u);
+    EXPECT_EQ(ch.size(1), 2u);
+}
+
+TEST(PriorityChannel, InvalidLaneIsRejected) {
+    PriorityChannel<int, 2, 2> ch;
+
+    EXPECT_EQ(ch.add(2, 1), ChannelBase::Result::INVALID);
+    EXPECT_EQ(ch.try_add(100, 1), ChannelBase::Result::INVALID);
+    EXPECT_EQ(ch.size(2), 0u);
+    EXPECT_FALSE(ch.try_get());
+}
+
+TEST(PriorityChannel, StrictPriorityStarvesLowLane) {
+    PriorityChannel<int, 8, 2> ch;
+
+    ch.add(1, -1);
+    for (int i = 0; i < 8; ++i) {
+        ch.add(0, i);
+    }
+    for (int i = 0; i < 8; ++i) {
+        auto val = ch.get();
+        ASSERT_TRUE(val);
+        EXPECT_EQ(*val, i);
+    }
+    auto val = ch.get();
+    ASSERT_TRUE(val);
+    EXPECT_EQ(*val, -1);
+}
+
+TEST(PriorityChannel, AgingServesStarvedLane) {
+    PriorityChannel<int, 8, 2> ch(3);
+
+    ch.add(1, -1);
+    ch.add(1, -2);
+    for (int i = 0; i < 8; ++i) {
+        ch.add(0, i);
+    }
+
+    std::vector<int> order;
+    for (int i = 0; i < 10; ++i) {
+        auto val = ch.get();
+        ASSERT_TRUE(val);
+        order.push_back(*val);
+    }
+
+    std::vector<int> expected = {0, 1, 2, -1, 3, 4, 5, -2, 6, 7};
+    EXPECT_EQ(order, expected);
+}
+
+TEST(PriorityChannel, CloseDrainsAllLanes) {
+    PriorityChannel<int, 4, 2> ch;
+    ch.add(1, 1);
+    ch.add(0, 0);
+    ch.close();
+
+    EXPECT_EQ(ch.add(0, 5), ChannelBase::Result::CLOSED);
+
+    auto first = ch.get();
+    auto second = ch.get();
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    EXPECT_EQ(*first, 0);
+    EXPECT_EQ(*second, 1);
+
+    ChannelBase::Result result;
+    EXPECT_FALSE(ch.get(result));
+    EXPECT_EQ(result, ChannelBase::Result::CLOSED);
+}
+
+TEST(PriorityChannel, BlockedBulkProducerDoesNotBlockControl) {
+    PriorityChannel<int, 1, 2> ch;
+    ch.add(1, 1);
+
+    std::thread bulk([&]() {
+        EXPECT_EQ(ch.add(1, 2), ChannelBase::Result::OK); // Blocks until lane 1 drains
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(ch.try_add(0, 0), ChannelBase::Result::OK);
+
+    std::vector<int> order;
+    for (int i = 0; i < 3; ++i) {
+        auto val = ch.get();
+        ASSERT_TRUE(val);
+        order.push_back(*val);
+    }
+    bulk.join();
+
+    std::vector<int> expected = {0, 1, 2};
+    EXPECT_EQ(order, expected);
+}
+
+TEST(PriorityChannel, MultiProducerConsumer) {
+    constexpr int NUM_PRODUCERS = 4;
+    constexpr int MESSAGES_PER_PRODUCER = 1000;
+    PriorityChannel<int, 8, 4> ch(16);
+
+    std::atomic<long> sum_consumed{0};
+    std::atomic<int> count_received{0};
+    std::vector<std::thread> producers;
+    std::vector<std::thread> consumers;
+
+    for (int i = 0; i < NUM_PRODUCERS; ++i) {
+        producers.emplace_back([&, i]() {
+            for (int j = 0; j < MESSAGES_PER_PRODUCER; ++j) {
+                ch.add(static_cast<size_t>(i), i * MESSAGES_PER_PRODUCER + j);
+            }
+        });
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        consumers.emplace_back([&]() {
+            for (auto val = ch.get(); val; val = ch.get()) {
+                sum_consumed.fetch_add(*val, std::memory_order_relaxed);
+                count_received.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (auto& p : producers) p.join();
+    ch.close();
+    for (auto& c : consumers) c.join();
+
+    long total = NUM_PRODUCERS * MESSAGES_PER_PRODUCER;
+    EXPECT_EQ(count_received.load(), total);
+    EXPECT_EQ(sum_consumed.load(), total * (total - 1) / 2);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
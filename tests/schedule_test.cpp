@@ -0,0 +1,697 @@
+// Deterministic contention-schedule tests.
+//
+// Every channel thread runs under a cooperative scheduler: only one thread
+// executes at a time and, at each schedule point (mutex lock, condition
+// variable wait, and the CHANNEL_SCHEDULE_POINT() hooks around atomics in
+// adder/getter), a seeded RNG picks which thread runs next. The same seed
+// always produces the same interleaving, so a failure is replayed exactly by
+// rerunning with that seed. Time is virtual too: the channel clock only moves
+// when the scheduler lets a timed wait expire, so deadlines never depend on
+// how fast the host runs.
+//
+//   CHANNEL_SCHEDULE_SEEDS=<n>  number of seeds per scenario (default 500)
+//   CHANNEL_SCHEDULE_SEED=<s>   run only seed <s>, to replay a failure
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace sched {
+
+// Steady clock that stands still until a timed wait expires, which jumps it
+// to that wait's deadline. Reset at the start of every Scheduler::run().
+struct Clock {
+    using duration = std::chrono::nanoseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<Clock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() {
+        return current();
+    }
+
+    static void advance_to(time_point deadline) {
+        current() = std::max(current(), deadline);
+    }
+
+    static void reset() {
+        current() = time_point();
+    }
+
+private:
+    static time_point& current() {
+        static time_point now;
+        return now;
+    }
+};
+
+class Scheduler {
+public:
+    explicit Scheduler(uint64_t seed) : seed_(seed), rng_(seed) {}
+
+    static Scheduler*& active() {
+        static Scheduler* scheduler = nullptr;
+        return scheduler;
+    }
+
+    // Runs each body on its own thread, one step at a time, until all finish.
+    // A deadlock aborts the process after printing the seed to replay.
+    void run(const std::vector<std::function<void()>>& bodies) {
+        active() = this;
+        Clock::reset();
+        threads_.assign(bodies.size(), Thread());
+
+        std::vector<std::thread> workers;
+        for (size_t id = 0; id < bodies.size(); ++id) {
+            workers.emplace_back([this, id, &bodies]() {
+                self() = id;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    wait_turn(lock);
+                }
+                bodies[id]();
+
+                std::unique_lock<std::mutex> lock(mutex_);
+                threads_[id].state_ = State::Done;
+                pick_next();
+            });
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            pick_next();
+            cv_.wait(lock, [this] { return finished_; });
+        }
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        active() = nullptr;
+    }
+
+    // Lets another runnable thread go first
+    void yield() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        pick_next();
+        wait_turn(lock);
+    }
+
+    // Parks the calling thread until woken on `object`; returns true if a
+    // timed wait was woken because nothing else could run
+    bool block(const void* object, bool timed) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        Thread& thread = threads_[self()];
+        thread.state_ = State::Blocked;
+        thread.waiting_on_ = object;
+        thread.timed_ = timed;
+        thread.timed_out_ = false;
+        pick_next();
+        wait_turn(lock);
+        return thread.timed_out_;
+    }
+
+    void wake_one(const void* object) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        std::vector<size_t> waiters = blocked_on(object);
+        if (!waiters.empty()) {
+            threads_[waiters[rng_() % waiters.size()]].state_ = State::Runnable;
+        }
+    }
+
+    void wake_all(const void* object) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (size_t id : blocked_on(object)) {
+            threads_[id].state_ = State::Runnable;
+        }
+    }
+
+    const std::vector<size_t>& trace() const {
+        return trace_;
+    }
+
+    static bool managed() {
+        return active() != nullptr && self() != kNone;
+    }
+
+private:
+    static constexpr size_t kNone = SIZE_MAX;
+
+    enum class State { Runnable, Blocked, Done };
+
+    struct Thread {
+        State state_ = State::Runnable;
+        const void* waiting_on_ = nullptr;
+        bool timed_ = false;
+        bool timed_out_ = false;
+    };
+
+    static size_t& self() {
+        thread_local size_t id = kNone;
+        return id;
+    }
+
+    std::vector<size_t> blocked_on(const void* object) const {
+        std::vector<size_t> ids;
+        for (size_t id = 0; id < threads_.size(); ++id) {
+            if (threads_[id].state_ == State::Blocked && threads_[id].waiting_on_ == object) {
+                ids.push_back(id);
+            }
+        }
+        return ids;
+    }
+
+    // Chooses the next thread to run; called with mutex_ held
+    void pick_next() {
+        std::vector<size_t> runnable;
+        for (size_t id = 0; id < threads_.size(); ++id) {
+            if (threads_[id].state_ == State::Runnable) {
+                runnable.push_back(id);
+            }
+        }
+
+        if (runnable.empty()) {
+            // Nothing can run, so let a timed wait expire
+            for (size_t id = 0; id < threads_.size(); ++id) {
+                if (threads_[id].state_ == State::Blocked && threads_[id].timed_) {
+                    runnable.push_back(id);
+                }
+            }
+            if (!runnable.empty()) {
+                size_t id = runnable[rng_() % runnable.size()];
+                threads_[id].state_ = State::Runnable;
+                threads_[id].timed_out_ = true;
+                runnable = {id};
+            }
+        }
+
+        if (runnable.empty()) {
+            bool all_done = std::all_of(threads_.begin(), threads_.end(),
+                                        [](const Thread& t) { return t.state_ == State::Done; });
+            if (!all_done) {
+                std::fprintf(stderr, "deadlock: every thread is blocked, replay with CHANNEL_SCHEDULE_SEED=%llu\n",
+                             static_cast<unsigned long long>(seed_));
+                std::abort();
+            }
+            current_ = kNone;
+            finished_ = true;
+            cv_.notify_all();
+            return;
+        }
+
+        current_ = runnable[rng_() % runnable.size()];
+        trace_.push_back(current_);
+        cv_.notify_all();
+    }
+
+    void wait_turn(std::unique_lock<std::mutex>& lock) {
+        size_t id = self();
+        cv_.wait(lock, [this, id] { return current_ == id; });
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint64_t seed_;
+    std::mt19937_64 rng_;
+    std::vector<Thread> threads_;
+    std::vector<size_t> trace_;
+    size_t current_ = kNone;
+    bool finished_ = false;
+};
+
+inline void yield() {
+    if (Scheduler::managed()) {
+        Scheduler::active()->yield();
+    }
+}
+
+// Mutex whose contention is resolved by the scheduler
+class Mutex {
+public:
+    void lock() {
+        yield();
+        while (locked_) {
+            Scheduler::active()->block(this, false);
+        }
+        locked_ = true;
+    }
+
+    bool try_lock() {
+        yield();
+        if (locked_) {
+            return false;
+        }
+        locked_ = true;
+        return true;
+    }
+
+    void unlock() {
+        locked_ = false;
+        if (Scheduler::managed()) {
+            Scheduler::active()->wake_all(this);
+        }
+    }
+
+private:
+    bool locked_ = false; // Only one thread runs at a time, so no atomics needed
+};
+
+// Condition variable whose wakeups are chosen by the scheduler. Timed waits
+// only expire when no other thread can run, and then advance the virtual
+// clock to their deadline.
+class ConditionVariable {
+public:
+    void wait(std::unique_lock<Mutex>& lock) {
+        lock.unlock();
+        if (Scheduler::managed()) {
+            Scheduler::active()->block(this, false);
+        }
+        lock.lock();
+    }
+
+    template <typename Predicate>
+    void wait(std::unique_lock<Mutex>& lock, Predicate pred) {
+        while (!pred()) {
+            wait(lock);
+        }
+    }
+
+    std::cv_status wait_until(std::unique_lock<Mutex>& lock, Clock::time_point deadline) {
+        lock.unlock();
+        bool timed_out = Scheduler::managed() && Scheduler::active()->block(this, true);
+        if (timed_out) {
+            Clock::advance_to(deadline);
+        }
+        lock.lock();
+        return timed_out ? std::cv_status::timeout : std::cv_status::no_timeout;
+    }
+
+    template <typename Predicate>
+    bool wait_until(std::unique_lock<Mutex>& lock, Clock::time_point deadline, Predicate pred) {
+        while (!pred()) {
+            if (wait_until(lock, deadline) == std::cv_status::timeout) {
+                return pred();
+            }
+        }
+        return true;
+    }
+
+    void notify_one() {
+        if (Scheduler::managed()) {
+            Scheduler::active()->wake_one(this);
+        }
+    }
+
+    void notify_all() {
+        if (Scheduler::managed()) {
+            Scheduler::active()->wake_all(this);
+        }
+    }
+};
+
+} // namespace sched
+
+#define CHANNEL_MUTEX_TYPE sched::Mutex
+#define CHANNEL_CONDITION_VARIABLE_TYPE sched::ConditionVariable
+#define CHANNEL_CLOCK sched::Clock
+#define CHANNEL_SCHEDULE_POINT() sched::yield()
+#include "channel.hpp"
+
+namespace {
+
+std::vector<uint64_t> seeds() {
+    if (const char* seed = std::getenv("CHANNEL_SCHEDULE_SEED")) {
+        return {std::strtoull(seed, nullptr, 10)};
+    }
+    uint64_t count = 500;
+    if (const char* env = std::getenv("CHANNEL_SCHEDULE_SEEDS")) {
+        count = std::strtoull(env, nullptr, 10);
+    }
+    std::vector<uint64_t> result;
+    for (uint64_t seed = 1; seed <= count; ++seed) {
+        result.push_back(seed);
+    }
+    return result;
+}
+
+// Encodes producer id and sequence number so order can be checked per producer
+constexpr int kTag = 1000;
+
+struct Received {
+    std::vector<std::vector<int>> per_consumer;
+    std::vector<int> accepted_per_producer;
+};
+
+// Each consumer must see every producer's items in increasing order, and
+// together they must see exactly the accepted items, once each.
+void check_delivery(const Received& received, size_t producers) {
+    std::vector<std::vector<int>> seen(producers);
+    for (const auto& items : received.per_consumer) {
+        std::vector<int> last(producers, -1);
+        for (int item : items) {
+            size_t producer = static_cast<size_t>(item / kTag);
+            int sequence = item % kTag;
+            ASSERT_LT(producer, producers);
+            EXPECT_GT(sequence, last[producer]) << "FIFO violated for producer " << producer;
+            last[producer] = sequence;
+            seen[producer].push_back(sequence);
+        }
+    }
+
+    for (size_t producer = 0; producer < producers; ++producer) {
+        std::sort(seen[producer].begin(), seen[producer].end());
+        std::vector<int> expected(received.accepted_per_producer[producer]);
+        for (size_t i = 0; i < expected.size(); ++i) {
+            expected[i] = static_cast<int>(i);
+        }
+        EXPECT_EQ(seen[producer], expected) << "lost or duplicated items for producer " << producer;
+    }
+}
+
+template <typename Scenario>
+void run_seeds(Scenario scenario) {
+    for (uint64_t seed : seeds()) {
+        SCOPED_TRACE("replay with CHANNEL_SCHEDULE_SEED=" + std::to_string(seed));
+        scenario(seed);
+        if (::testing::Test::HasFailure()) {
+            return;
+        }
+    }
+}
+
+} // namespace
+
+TEST(ScheduleHarness, SameSeedReplaysSameSchedule) {
+    auto trace_for = [](uint64_t seed) {
+        Channel<int, 2> ch;
+        sched::Scheduler scheduler(seed);
+        scheduler.run({
+            [&]() { for (int i = 0; i < 5; ++i) ch.add(i); ch.close(); },
+            [&]() { while (ch.get()) {} },
+            [&]() { while (ch.get()) {} },
+        });
+        return scheduler.trace();
+    };
+
+    EXPECT_EQ(trace_for(42), trace_for(42));
+    EXPECT_NE(trace_for(42), trace_for(43));
+}
+
+TEST(ScheduleHarness, CoalescingDeadlinesUseVirtualTime) {
+    struct Run {
+        std::vector<size_t> trace;
+        std::vector<size_t> batches;
+        sched::Clock::duration elapsed;
+    };
+
+    // A 10 s delay would stall a real clock; the virtual one jumps to it
+    auto run_once = [](uint64_t seed) {
+        Channel<int, 4> ch;
+        ch.set_wakeup_coalescing(3, std::chrono::seconds(10));
+        Channel<int, 4> acks;
+        Run run;
+
+        sched::Scheduler scheduler(seed);
+        scheduler.run({
+            [&]() {
+                // Two items never fill the batch, only the deadline releases them
+                ch.add(0);
+                ch.add(1);
+                acks.get();
+                for (int i = 2; i < 7; ++i) ch.add(i);
+                ch.close();
+            },
+            [&]() {
+                std::vector<Channel<int, 4>::pointer> batch;
+                while (ch.get_batch(batch, 4) != 0) {
+                    run.batches.push_back(batch.size());
+                    batch.clear();
+                    acks.add(1);
+                }
+            },
+        });
+        run.trace = scheduler.trace();
+        run.elapsed = sched::Clock::now().time_since_epoch();
+        return run;
+    };
+
+    run_seeds([&](uint64_t seed) {
+        Run first = run_once(seed);
+        Run second = run_once(seed);
+        EXPECT_EQ(first.trace, second.trace);
+        EXPECT_EQ(first.batches, second.batches);
+        EXPECT_EQ(first.elapsed, second.elapsed);
+        EXPECT_GE(first.elapsed, std::chrono::seconds(10));
+        EXPECT_EQ(first.elapsed % std::chrono::seconds(10), sched::Clock::duration::zero());
+    });
+}
+
+TEST(ScheduleHarness, BufferedBlockingAddGet) {
+    run_seeds([](uint64_t seed) {
+        constexpr size_t PRODUCERS = 2;
+        constexpr size_t CONSUMERS = 2;
+        constexpr int ITEMS = 4;
+
+        Channel<int, 2> ch;
+        Received received;
+        received.per_consumer.resize(CONSUMERS);
+        received.accepted_per_producer.assign(PRODUCERS, ITEMS);
+        std::atomic<size_t> producers_left{PRODUCERS};
+
+        std::vector<std::function<void()>> bodies;
+        for (size_t p = 0; p < PRODUCERS; ++p) {
+            bodies.push_back([&, p]() {
+                for (int i = 0; i < ITEMS; ++i) {
+                    EXPECT_EQ(ch.add(static_cast<int>(p) * kTag + i), ChannelBase::Result::OK);
+                }
+                if (--producers_left == 0) {
+                    ch.close();
+                }
+            });
+        }
+        for (size_t c = 0; c < CONSUMERS; ++c) {
+            bodies.push_back([&, c]() {
+                ChannelBase::Result result;
+                for (auto val = ch.get(result); val; val = ch.get(result)) {
+                    received.per_consumer[c].push_back(*val);
+                }
+                EXPECT_EQ(result, ChannelBase::Result::CLOSED);
+            });
+        }
+
+        sched::Scheduler scheduler(seed);
+        scheduler.run(bodies);
+        check_delivery(received, PRODUCERS);
+
+        ChannelBase::Result result;
+        EXPECT_FALSE(ch.try_get(result));
+        EXPECT_EQ(result, ChannelBase::Result::CLOSED);
+        EXPECT_EQ(ch.add(0), ChannelBase::Result::CLOSED);
+    });
+}
+
+TEST(ScheduleHarness, BufferedTryAddTryGet) {
+    run_seeds([](uint64_t seed) {
+        constexpr size_t PRODUCERS = 2;
+        constexpr int ITEMS = 3;
+
+        Channel<int, 1> ch;
+        Received received;
+        received.per_consumer.resize(2);
+        received.accepted_per_producer.assign(PRODUCERS, ITEMS);
+        std::atomic<size_t> producers_left{PRODUCERS};
+
+        std::vector<std::function<void()>> bodies;
+        for (size_t p = 0; p < PRODUCERS; ++p) {
+            bodies.push_back([&, p]() {
+                for (int i = 0; i < ITEMS; ++i) {
+                    while (ch.try_add(static_cast<int>(p) * kTag + i) != ChannelBase::Result::OK) {
+                        sched::yield();
+                    }
+                }
+                if (--producers_left == 0) {
+                    ch.close();
+                }
+            });
+        }
+        // One polling consumer and one blocking consumer
+        bodies.push_back([&]() {
+            ChannelBase::Result result = ChannelBase::Result::OK;
+            while (result != ChannelBase::Result::CLOSED) {
+                if (auto val = ch.try_get(result)) {
+                    received.per_consumer[0].push_back(*val);
+                } else {
+                    sched::yield();
+                }
+            }
+        });
+        bodies.push_back([&]() {
+            for (auto val = ch.get(); val; val = ch.get()) {
+                received.per_consumer[1].push_back(*val);
+            }
+        });
+
+        sched::Scheduler scheduler(seed);
+        scheduler.run(bodies);
+        check_delivery(received, PRODUCERS);
+    });
+}
+
+TEST(ScheduleHarness, CloseDrainsBeforeClosed) {
+    run_seeds([](uint64_t seed) {
+        constexpr int ITEMS = 3;
+
+        Channel<int, 4> ch;
+        Received received;
+        received.per_consumer.resize(2);
+        received.accepted_per_producer.assign(2, 0);
+
+        std::vector<std::function<void()>> bodies;
+        // Producer 0 fills and closes; producer 1 races a late add against the close
+        bodies.push_back([&]() {
+            for (int i = 0; i < ITEMS; ++i) {
+                EXPECT_EQ(ch.add(i), ChannelBase::Result::OK);
+            }
+            received.accepted_per_producer[0] = ITEMS;
+            ch.close();
+        });
+        bodies.push_back([&]() {
+            if (ch.try_add(kTag) == ChannelBase::Result::OK) {
+                received.accepted_per_producer[1] = 1;
+            }
+        });
+        for (size_t c = 0; c < 2; ++c) {
+            bodies.push_back([&, c]() {
+                ChannelBase::Result result;
+                for (auto val = ch.get(result); val; val = ch.get(result)) {
+                    received.per_consumer[c].push_back(*val);
+                }
+                EXPECT_EQ(result, ChannelBase::Result::CLOSED);
+            });
+        }
+
+        sched::Scheduler scheduler(seed);
+        scheduler.run(bodies);
+        check_delivery(received, 2);
+        EXPECT_EQ(ch.size(), 0u);
+    });
+}
+
+TEST(ScheduleHarness, UnbufferedHandoff) {
+    run_seeds([](uint64_t seed) {
+        constexpr size_t PAIRS = 3;
+
+        Channel<int, 0> ch;
+        Received received;
+        received.per_consumer.resize(PAIRS);
+        received.accepted_per_producer.assign(PAIRS, 2);
+
+        std::vector<std::function<void()>> bodies;
+        for (size_t p = 0; p < PAIRS; ++p) {
+            bodies.push_back([&, p]() {
+                for (int i = 0; i < 2; ++i) {
+                    EXPECT_EQ(ch.add(static_cast<int>(p) * kTag + i), ChannelBase::Result::OK);
+                }
+            });
+        }
+        for (size_t c = 0; c < PAIRS; ++c) {
+            bodies.push_back([&, c]() {
+                for (int i = 0; i < 2; ++i) {
+                    // No ASSERT_*: returning early would leave the producers blocked
+                    auto val = ch.get();
+                    EXPECT_TRUE(val);
+                    if (!val) {
+                        continue;
+                    }
+                    received.per_consumer[c].push_back(*val);
+                }
+            });
+        }
+
+        sched::Scheduler scheduler(seed);
+        scheduler.run(bodies);
+        check_delivery(received, PAIRS);
+    });
+}
+
+TEST(ScheduleHarness, UnbufferedCloseWakesEveryone) {
+    run_seeds([](uint64_t seed) {
+        Channel<int, 0> ch;
+        std::atomic<int> delivered{0};
+        std::atomic<int> accepted{0};
+
+        std::vector<std::function<void()>> bodies;
+        for (int c = 0; c < 2; ++c) {
+            bodies.push_back([&]() {
+                for (auto val = ch.get(); val; val = ch.get()) {
+                    delivered++;
+                }
+            });
+        }
+        bodies.push_back([&]() {
+            if (ch.add(1) == ChannelBase::Result::OK) {
+                accepted++;
+            }
+        });
+        bodies.push_back([&]() {
+            ch.close();
+        });
+
+        sched::Scheduler scheduler(seed);
+        scheduler.run(bodies);
+        EXPECT_EQ(delivered.load(), accepted.load());
+    });
+}
+
+TEST(ScheduleHarness, CoalescedBatches) {
+    run_seeds([](uint64_t seed) {
+        constexpr size_t PRODUCERS = 2;
+        constexpr int ITEMS = 4;
+
+        Channel<int, 4> ch;
+        ch.set_wakeup_coalescing(3, std::chrono::microseconds(100));
+        Received received;
+        received.per_consumer.resize(1);
+        received.accepted_per_producer.assign(PRODUCERS, ITEMS);
+        std::atomic<size_t> producers_left{PRODUCERS};
+
+        std::vector<std::function<void()>> bodies;
+        for (size_t p = 0; p < PRODUCERS; ++p) {
+            bodies.push_back([&, p]() {
+                for (int i = 0; i < ITEMS; ++i) {
+                    ch.add(static_cast<int>(p) * kTag + i);
+                }
+                if (--producers_left == 0) {
+                    ch.close();
+                }
+            });
+        }
+        bodies.push_back([&]() {
+            std::vector<Channel<int, 4>::pointer> batch;
+            while (ch.get_batch(batch, 4) != 0) {
+                for (auto& val : batch) {
+                    received.per_consumer[0].push_back(*val);
+                }
+                batch.clear();
+            }
+        });
+
+        sched::Scheduler scheduler(seed);
+        scheduler.run(bodies);
+        check_delivery(received, PRODUCERS);
+    });
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
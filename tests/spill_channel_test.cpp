@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <string>
+#include "spill_channel.hpp"
+
+TEST(SpillChannel, SpillsInsteadOfBlocking) {
+    SpillChannel<int, 4> ch(::testing::TempDir());
+
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(ch.try_add(i), ChannelBase::Result::OK);
+    }
+    EXPECT_EQ(ch.size(), 1000u);
+    EXPECT_EQ(ch.spilled(), 996u);
+
+    for (int i = 0; i < 1000; ++i) {
+        auto val = ch.try_get();
+        ASSERT_TRUE(val);
+        EXPECT_EQ(*val, i);
+    }
+    EXPECT_EQ(ch.size(), 0u);
+    EXPECT_FALSE(ch.try_get());
+}
+
+TEST(SpillChannel, InterleavedAddAndGetKeepsOrder) {
+    SpillChannel<std::string, 2> ch(::testing::TempDir(), 1024, 4);
+
+    int next_in = 0;
+    int next_out = 0;
+    for (int round = 0; round < 200; ++round) {
+        for (int i = 0; i < 5; ++i) {
+            ASSERT_EQ(ch.try_add(std::to_string(next_in++)), ChannelBase::Result::OK);
+        }
+        for (int i = 0; i < 4; ++i) {
+            auto val = ch.get();
+            ASSERT_TRUE(val);
+            EXPECT_EQ(*val, std::to_string(next_out++));
+        }
+    }
+    while (ch.size() != 0) {
+        auto val = ch.get();
+        ASSERT_TRUE(val);
+        EXPECT_EQ(*val, std::to_string(next_out++));
+    }
+    EXPECT_EQ(next_in, next_out);
+}
+
+TEST(SpillChannel, SegmentCapAppliesBackpressure) {
+    // Each record is a 4-byte header plus the int, so a segment holds 4 of them
+    SpillChannel<int, 1> ch(::testing::TempDir(), 32, 2);
+
+    EXPECT_EQ(ch.try_add(0), ChannelBase::Result::OK); // Ring
+    for (int i = 1; i <= 8; ++i) {
+        EXPECT_EQ(ch.try_add(i), ChannelBase::Result::OK); // Two segments
+    }
+    EXPECT_EQ(ch.try_add(9), ChannelBase::Result::FULL);
+
+    std::thread producer([&]() {
+        EXPECT_EQ(ch.add(9), ChannelBase::Result::OK); // Blocks until the log has room
+    });
+
+    for (int i = 0; i <= 9; ++i) {
+        auto val = ch.get();
+        ASSERT_TRUE(val);
+        EXPECT_EQ(*val, i);
+    }
+    producer.join();
+}
+
+TEST(SpillChannel, SegmentsAreRecycled) {
+    SpillChannel<int, 1> ch(::testing::TempDir(), 64, 3);
+
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 20; ++i) {
+            ASSERT_EQ(ch.try_add(round * 20 + i), ChannelBase::Result::OK);
+        }
+        for (int i = 0; i < 20; ++i) {
+            auto val = ch.get();
+            ASSERT_TRUE(val);
+            EXPECT_EQ(*val, round * 20 + i);
+        }
+    }
+}
+
+TEST(SpillChannel, CloseDrainsSpilledItems) {
+    SpillChannel<int, 2> ch(::testing::TempDir());
+    for (int i = 0; i < 10; ++i) {
+        ch.add(i);
+    }
+    ch.close();
+    EXPECT_EQ(ch.add(10), ChannelBase::Result::CLOSED);
+
+    int expected = 0;
+    for (auto val = ch.get(); val; val = ch.get()) {
+        EXPECT_EQ(*val, expected++);
+    }
+    EXPECT_EQ(expected, 10);
+
+    ChannelBase::Result result;
+    EXPECT_FALSE(ch.try_get(result));
+    EXPECT_EQ(result, ChannelBase::Result::CLOSED);
+}
+
+TEST(SpillChannel, MultiProducerConsumer) {
+    constexpr int NUM_PRODUCERS = 4;
+    constexpr int MESSAGES_PER_PRODUCER = 2000;
+    SpillChannel<int, 8> ch(::testing::TempDir(), 4096, 8);
+
+    std::atomic<long> sum_consumed{0};
+    std::atomic<int> count_received{0};
+    std::vector<std::thread> producers;
+    std::vector<std::thread> consumers;
+
+    for (int i = 0; i < NUM_PRODUCERS; ++i) {
+        producers.emplace_back([&, i]() {
+            for (int j = 0; j < MESSAGES_PER_PRODUCER; ++j) {
+                ch.add(i * MESSAGES_PER_PRODUCER + j);
+            }
+        });
+    }
+
+    consumers.emplace_back([&]() {
+        std::vector<int> last(NUM_PRODUCERS, -1);
+        for (auto val = ch.get(); val; val = ch.get()) {
+            int producer = *val / MESSAGES_PER_PRODUCER;
+            EXPECT_GT(*val, last[producer]); // Per-producer FIFO
+            last[producer] = *val;
+            sum_consumed.fetch_add(*val, std::memory_order_relaxed);
+            count_received.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    for (auto& p : producers) p.join();
+    ch.close();
+    for (auto& c : consumers) c.join();
+
+    long total = NUM_PRODUCERS * MESSAGES_PER_PRODUCER;
+    EXPECT_EQ(count_received.load(), total);
+    EXPECT_EQ(sum_consumed.load(), total * (total - 1) / 2);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include "timer.hpp"
+
+using namespace std::chrono_literals;
+
+TEST(Timer, AfterFiresOnceThenCloses) {
+    auto start = std::chrono::steady_clock::now();
+    auto ch = after(20ms);
+
+    auto fired = ch->get();
+    ASSERT_TRUE(fired);
+    EXPECT_GE(*fired - start, 20ms);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+
+    ChannelBase::Result result;
+    EXPECT_FALSE(ch->get(result));
+    EXPECT_EQ(result, ChannelBase::Result::CLOSED);
+}
+
+TEST(Timer, AfterOrdering) {
+    auto late = after(60ms);
+    auto early = after(10ms);
+
+    ASSERT_TRUE(early->get());
+    EXPECT_EQ(late->try_get(), nullptr); // Not yet
+    ASSERT_TRUE(late->get());
+}
+
+TEST(Timer, LongDelayCascades) {
+    // More than 64 ticks away, so it starts on level 1
+    auto start = std::chrono::steady_clock::now();
+    auto ch = after(150ms);
+
+    ASSERT_TRUE(ch->get());
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(elapsed, 150ms);
+    EXPECT_LT(elapsed, 1s);
+}
+
+TEST(Timer, TickerTicksUntilClosed) {
+    auto ch = ticker(5ms);
+
+    auto previous = ch->get();
+    ASSERT_TRUE(previous);
+    for (int i = 0; i < 5; ++i) {
+        auto tick = ch->get();
+        ASSERT_TRUE(tick);
+        EXPECT_GT(*tick, *previous);
+        previous = std::move(tick);
+    }
+
+    ch->close();
+    while (ch->get()) {
+    }
+    EXPECT_EQ(ch->try_add(std::chrono::steady_clock::now()), ChannelBase::Result::CLOSED);
+}
+
+TEST(Timer, SlowReaderDropsTicks) {
+    auto ch = ticker(1ms);
+    std::this_thread::sleep_for(50ms);
+
+    // Only one tick fits; the rest were dropped rather than queued
+    EXPECT_EQ(ch->size(), 1u);
+    ASSERT_TRUE(ch->try_get());
+    ch->close();
+}
+
+TEST(Timer, DroppedChannelsAreCancelled) {
+    for (int i = 0; i < 100; ++i) {
+        ticker(1ms);
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (TimerWheel::instance().pending() != 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(5ms);
+    }
+    EXPECT_EQ(TimerWheel::instance().pending(), 0u);
+}
+
+TEST(Timer, ManyTimersShareOneThread) {
+    constexpr int NUM_TIMERS = 10000;
+    std::vector<std::shared_ptr<TimerChannel>> channels;
+    channels.reserve(NUM_TIMERS);
+
+    for (int i = 0; i < NUM_TIMERS; ++i) {
+        channels.push_back(after(std::chrono::milliseconds(1 + i % 100)));
+    }
+
+    int fired = 0;
+    for (auto& ch : channels) {
+        if (ch->get()) {
+            fired++;
+        }
+    }
+    EXPECT_EQ(fired, NUM_TIMERS);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}